@@ -0,0 +1,58 @@
+// derive(PartialEq/PartialOrd/Ord) on enums compare the variant index before any fields
+
+#[derive(Debug, PartialEq, Eq, PartialOrd, Ord)]
+enum Mixed {
+    A,
+    B(u32),
+    C,
+    D { x: u32, y: String },
+}
+
+#[derive(Debug, PartialEq, Eq, PartialOrd, Ord)]
+enum Explicit {
+    X = 3,
+    Y = 1,
+    Z = 7,
+}
+
+#[derive(Debug, PartialEq, Eq, PartialOrd, Ord)]
+#[repr(u8)]
+enum Repr {
+    P = 200,
+    Q = 10,
+}
+
+#[test]
+fn mixed_variants()
+{
+    use std::cmp::Ordering;
+    assert_eq!(Mixed::A, Mixed::A);
+    assert!(Mixed::A != Mixed::C);
+    assert!(Mixed::B(1) != Mixed::C);
+    assert_eq!(Mixed::B(1), Mixed::B(1));
+    assert!(Mixed::B(1) != Mixed::B(2));
+    assert_eq!(Mixed::D { x: 1, y: "a".to_owned() }, Mixed::D { x: 1, y: "a".to_owned() });
+    assert!(Mixed::D { x: 1, y: "a".to_owned() } != Mixed::D { x: 1, y: "b".to_owned() });
+
+    assert_eq!(Mixed::A.cmp(&Mixed::C), Ordering::Less);
+    assert_eq!(Mixed::C.cmp(&Mixed::B(100)), Ordering::Greater);
+    assert_eq!(Mixed::B(3).cmp(&Mixed::B(2)), Ordering::Greater);
+    assert_eq!(Mixed::C.partial_cmp(&Mixed::C), Some(Ordering::Equal));
+    assert_eq!(Mixed::D { x: 1, y: "a".to_owned() }.cmp(&Mixed::D { x: 1, y: "b".to_owned() }), Ordering::Less);
+    assert_eq!(Mixed::D { x: 0, y: String::new() }.cmp(&Mixed::A), Ordering::Greater);
+}
+
+// Ordering is declaration order, not discriminant order
+#[test]
+fn explicit_discriminants()
+{
+    use std::cmp::Ordering;
+    assert_eq!(Explicit::X, Explicit::X);
+    assert!(Explicit::X != Explicit::Y);
+    assert_eq!(Explicit::X.cmp(&Explicit::Y), Ordering::Less);
+    assert_eq!(Explicit::Z.cmp(&Explicit::Y), Ordering::Greater);
+
+    assert_eq!(Repr::P, Repr::P);
+    assert!(Repr::P != Repr::Q);
+    assert_eq!(Repr::P.cmp(&Repr::Q), Ordering::Less);
+}
@@ -0,0 +1,48 @@
+// Unsizing coercions move out of their source, so it must only be dropped once
+use std::cell::Cell;
+use std::rc::Rc;
+
+struct DropFlag<'a>(&'a Cell<i32>);
+impl<'a> ::std::ops::Drop for DropFlag<'a>
+{
+    fn drop(&mut self) {
+        self.0.set( self.0.get() + 1 );
+    }
+}
+
+trait Tr {}
+impl<'a> Tr for DropFlag<'a> {}
+
+#[test]
+fn box_array_to_slice()
+{
+    let drop_count = Cell::new(0);
+    {
+        let b: Box<[DropFlag; 2]> = Box::new([DropFlag(&drop_count), DropFlag(&drop_count)]);
+        let s: Box<[DropFlag]> = b;
+        assert_eq!(s.len(), 2);
+    }
+    assert_eq!(drop_count.get(), 2);
+}
+
+#[test]
+fn box_to_trait_object()
+{
+    let drop_count = Cell::new(0);
+    {
+        let _s: Box<Tr> = Box::new(DropFlag(&drop_count));
+        assert_eq!(drop_count.get(), 0);
+    }
+    assert_eq!(drop_count.get(), 1);
+}
+
+#[test]
+fn rc_to_trait_object()
+{
+    let drop_count = Cell::new(0);
+    {
+        let r = Rc::new(DropFlag(&drop_count));
+        let _s: Rc<Tr> = r;
+    }
+    assert_eq!(drop_count.get(), 1);
+}
@@ -530,9 +530,9 @@ public:
     };
 
     // TODO: Document difference between namespace and Type
-    ::std::unordered_map< ::std::string, IndexEnt >    m_namespace_items;
-    ::std::unordered_map< ::std::string, IndexEnt >    m_type_items;
-    ::std::unordered_map< ::std::string, IndexEnt >    m_value_items;
+    ::std::unordered_map< RcString, IndexEnt >    m_namespace_items;
+    ::std::unordered_map< RcString, IndexEnt >    m_type_items;
+    ::std::unordered_map< RcString, IndexEnt >    m_value_items;
 
 public:
     Module() {}
@@ -24,14 +24,20 @@ class RustPrinter:
     ::std::ostream& m_os;
     int m_indent_level;
     bool m_expr_root;   //!< used to allow 'if' and 'match' to behave differently as standalone exprs
+
+    const DumpFilter&   m_filter;
+    ::std::string   m_mod_path; //!< Path of the current module (only maintained when filtering)
 public:
-    RustPrinter(::std::ostream& os):
+    RustPrinter(::std::ostream& os, const DumpFilter& filter):
         m_os(os),
         m_indent_level(0),
-        m_expr_root(false)
+        m_expr_root(false),
+        m_filter(filter)
     {}
 
+    void handle_root(const AST::Crate& crate);
     void handle_module(const AST::Module& mod);
+    void handle_impl_item(const AST::Impl::ImplItem& it);
     void handle_struct(const AST::Struct& s);
     void handle_enum(const AST::Enum& s);
     void handle_trait(const AST::Trait& s);
@@ -567,16 +573,34 @@ private:
     void print_pattern(const AST::Pattern& p, bool is_refutable);
     void print_type(const TypeRef& t);
 
+    bool select_item(const ::std::string& path);
+
     void inc_indent();
     RepeatLitStr indent();
     void dec_indent();
 };
 
-void Dump_Rust(const char *filename, const AST::Crate& crate)
+void Dump_Rust(::std::ostream& sink, const AST::Crate& crate, const DumpFilter& filter)
+{
+    RustPrinter printer(sink, filter);
+    printer.handle_root(crate);
+}
+
+void RustPrinter::handle_root(const AST::Crate& crate)
+{
+    m_mod_path = FMT("\"" << crate.m_crate_name << "\"");
+    handle_module(crate.root_module());
+}
+
+/// Check if an item is to be printed (printing its path if only some items are selected)
+bool RustPrinter::select_item(const ::std::string& path)
 {
-    ::std::ofstream os(filename);
-    RustPrinter printer(os);
-    printer.handle_module(crate.root_module());
+    if( m_filter.is_all() )
+        return true;
+    if( !m_filter.matches(path) )
+        return false;
+    m_os << indent() << "// " << path << "\n";
+    return true;
 }
 
 void RustPrinter::print_attrs(const AST::MetaItems& attrs)
@@ -591,6 +615,77 @@ void RustPrinter::handle_module(const AST::Module& mod)
 {
     bool need_nl = true;
 
+    if( !m_filter.is_all() )
+    {
+        // Only print selected items (prefixed by their path), skipping the module structure
+        for( const auto& item : mod.items() )
+        {
+            TU_MATCH_DEF(AST::Item, (item.data), (e),
+            (
+                ),
+            (Module,
+                auto saved_path = m_mod_path;
+                m_mod_path = FMT(m_mod_path << "::" << item.name);
+                handle_module(e);
+                m_mod_path = mv$(saved_path);
+                ),
+            (Type,
+                if( select_item(FMT(m_mod_path << "::" << item.name)) ) {
+                    m_os << indent() << "type " << item.name;
+                    print_params(e.params());
+                    m_os << " = " << e.type();
+                    print_bounds(e.params());
+                    m_os << ";\n";
+                }
+                ),
+            (Struct,
+                if( select_item(FMT(m_mod_path << "::" << item.name)) ) {
+                    m_os << indent() << "struct " << item.name;
+                    handle_struct(e);
+                }
+                ),
+            (Enum,
+                if( select_item(FMT(m_mod_path << "::" << item.name)) ) {
+                    m_os << indent() << "enum " << item.name;
+                    handle_enum(e);
+                }
+                ),
+            (Trait,
+                if( select_item(FMT(m_mod_path << "::" << item.name)) ) {
+                    m_os << indent() << "trait " << item.name;
+                    handle_trait(e);
+                }
+                ),
+            (Static,
+                if( select_item(FMT(m_mod_path << "::" << item.name)) ) {
+                    m_os << indent() << (e.s_class() == AST::Static::CONST ? "const " : e.s_class() == AST::Static::MUT ? "static mut " : "static ") << item.name << ": " << e.type() << " = ";
+                    e.value().visit_nodes(*this);
+                    m_os << ";\n";
+                }
+                ),
+            (Function,
+                if( select_item(FMT(m_mod_path << "::" << item.name)) ) {
+                    handle_function(item.is_pub, item.name, e);
+                }
+                ),
+            (Impl,
+                ::std::string impl_path;
+                if( e.def().trait().ent != AST::Path() )
+                    impl_path = FMT("<" << e.def().type() << " as " << e.def().trait().ent << ">");
+                else
+                    impl_path = FMT("<" << e.def().type() << ">");
+                for( const auto& it : e.items() )
+                {
+                    if( select_item(FMT(impl_path << "::" << it.name)) ) {
+                        handle_impl_item(it);
+                    }
+                }
+                )
+            )
+        }
+        return ;
+    }
+
     for( const auto& i : mod.items() )
     {
         if( !i.data.is_Use() )  continue ;
@@ -750,41 +845,46 @@ void RustPrinter::handle_module(const AST::Module& mod)
         inc_indent();
         for( const auto& it : i.items() )
         {
-            TU_MATCH_DEF(AST::Item, (*it.data), (e),
-            (
-                throw ::std::runtime_error(FMT("Unexpected item type in impl block - " << it.data->tag_str()));
-                ),
-            (None,
-                // Ignore, it's been deleted by #[cfg]
-                ),
-            (MacroInv,
-                // TODO: Dump macro invocations
-                ),
-            (Static,
-                m_os << indent();
-                switch(e.s_class())
-                {
-                case ::AST::Static::CONST:  m_os << "const ";   break;
-                case ::AST::Static::STATIC: m_os << "static ";  break;
-                case ::AST::Static::MUT:    m_os << "static mut ";  break;
-                }
-                m_os << it.name << ": " << e.type() << " = ";
-                e.value().visit_nodes(*this);
-                m_os << ";\n";
-                ),
-            (Type,
-                m_os << indent() << "type " << it.name << " = " << e.type() << ";\n";
-                ),
-            (Function,
-                handle_function(it.is_pub, it.name, e);
-                )
-            )
+            handle_impl_item(it);
         }
         dec_indent();
         m_os << indent() << "}\n";
     }
 }
 
+void RustPrinter::handle_impl_item(const AST::Impl::ImplItem& it)
+{
+    TU_MATCH_DEF(AST::Item, (*it.data), (e),
+    (
+        throw ::std::runtime_error(FMT("Unexpected item type in impl block - " << it.data->tag_str()));
+        ),
+    (None,
+        // Ignore, it's been deleted by #[cfg]
+        ),
+    (MacroInv,
+        // TODO: Dump macro invocations
+        ),
+    (Static,
+        m_os << indent();
+        switch(e.s_class())
+        {
+        case ::AST::Static::CONST:  m_os << "const ";   break;
+        case ::AST::Static::STATIC: m_os << "static ";  break;
+        case ::AST::Static::MUT:    m_os << "static mut ";  break;
+        }
+        m_os << it.name << ": " << e.type() << " = ";
+        e.value().visit_nodes(*this);
+        m_os << ";\n";
+        ),
+    (Type,
+        m_os << indent() << "type " << it.name << " = " << e.type() << ";\n";
+        ),
+    (Function,
+        handle_function(it.is_pub, it.name, e);
+        )
+    )
+}
+
 void RustPrinter::print_params(const AST::GenericParams& params)
 {
     if( params.ty_params().size() > 0 || params.lft_params().size() > 0 )
@@ -9,7 +9,7 @@ namespace AST {
 template <typename T>
 struct NamedNS
 {
-    ::std::string   name;
+    RcString    name;
     T   data;
     bool    is_pub;
 
@@ -19,7 +19,7 @@ struct NamedNS
     NamedNS(NamedNS&&) = default;
     NamedNS(const NamedNS&) = default;
     NamedNS& operator=(NamedNS&&) = default;
-    NamedNS(::std::string name, T data, bool is_pub):
+    NamedNS(RcString name, T data, bool is_pub):
         name( ::std::move(name) ),
         data( ::std::move(data) ),
         is_pub( is_pub )
@@ -41,7 +41,7 @@ struct Named:
     Named(Named&&) = default;
     Named(const Named&) = default;
     Named& operator=(Named&&) = default;
-    Named(::std::string name, T data, bool is_pub):
+    Named(RcString name, T data, bool is_pub):
         NamedNS<T>( ::std::move(name), ::std::move(data), is_pub )
     {}
 };
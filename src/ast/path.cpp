@@ -102,7 +102,7 @@ Ordering PathParams::ord(const PathParams& x) const
 }
 
 // --- AST::PathNode
-PathNode::PathNode(::std::string name, PathParams args):
+PathNode::PathNode(RcString name, PathParams args):
     m_name( mv$(name) ),
     m_params( mv$(args) )
 {
@@ -136,12 +136,12 @@ struct PathParams
 
 class PathNode
 {
-    ::std::string   m_name;
+    RcString    m_name;
     PathParams  m_params;
 public:
     PathNode() {}
-    PathNode(::std::string name, PathParams args = {});
-    const ::std::string& name() const { return m_name; }
+    PathNode(RcString name, PathParams args = {});
+    const RcString& name() const { return m_name; }
 
     const ::AST::PathParams& args() const { return m_params; }
           ::AST::PathParams& args()       { return m_params; }
@@ -257,11 +257,17 @@ public:
         tmp.nodes().push_back( mv$(pn) );
         return tmp;
     }
-    Path operator+(const ::std::string& s) const {
+    Path operator+(const RcString& s) const {
         Path tmp = Path(*this);
         tmp.append(PathNode(s, {}));
         return tmp;
     }
+    Path operator+(const ::std::string& s) const {
+        return *this + RcString(s);
+    }
+    Path operator+(const char* s) const {
+        return *this + RcString(s);
+    }
     Path operator+(const Path& x) const {
         return Path(*this) += x;
     }
@@ -10,6 +10,7 @@
 #include <cassert>
 #include <sstream>
 #include <memory>
+#include "include/rc_string.hpp"
 
 #ifdef _MSC_VER
 #define __attribute__(x)    /* no-op */
@@ -131,6 +132,15 @@ static inline Ordering ord(const ::std::string& l, const ::std::string& r)
     else
         return OrdLess;
 }
+static inline Ordering ord(const RcString& l, const RcString& r)
+{
+    if(l == r)
+        return OrdEqual;
+    else if( l > r )
+        return OrdGreater;
+    else
+        return OrdLess;
+}
 template<typename T>
 Ordering ord(const T& l, const T& r)
 {
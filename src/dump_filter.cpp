@@ -0,0 +1,120 @@
+/*
+ * MRustC - Rust Compiler
+ * - By John Hodge (Mutabah/thePowersGang)
+ *
+ * dump_filter.cpp
+ * - Item selection and output for the IR dumps (`--emit-dump`)
+ */
+#include <dump_filter.hpp>
+#include <fstream>
+#include <streambuf>
+#include <vector>
+#include <zlib.h>
+
+namespace {
+    bool glob_match(const char* pat, const char* s)
+    {
+        // Iterative match with single-star backtracking
+        const char* star_pat = nullptr;
+        const char* star_s = nullptr;
+        while( *s )
+        {
+            if( *pat == '*' ) {
+                star_pat = ++pat;
+                star_s = s;
+            }
+            else if( *pat == '?' || *pat == *s ) {
+                pat ++;
+                s ++;
+            }
+            else if( star_pat ) {
+                pat = star_pat;
+                s = ++star_s;
+            }
+            else {
+                return false;
+            }
+        }
+        while( *pat == '*' )
+            pat ++;
+        return *pat == '\0';
+    }
+
+    /// Stream buffer that writes to a gzip file
+    class GzStreamBuf:
+        public ::std::streambuf
+    {
+        gzFile  m_file;
+        ::std::vector<char> m_buffer;
+    public:
+        GzStreamBuf(const ::std::string& filename):
+            m_file( gzopen(filename.c_str(), "wb") ),
+            m_buffer(64*1024)
+        {
+            if( !m_file )
+                throw ::std::runtime_error("Unable to open " + filename);
+            this->setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+        }
+        ~GzStreamBuf()
+        {
+            this->sync();
+            gzclose(m_file);
+        }
+
+    protected:
+        int_type overflow(int_type c) override
+        {
+            if( this->sync() != 0 )
+                return traits_type::eof();
+            if( !traits_type::eq_int_type(c, traits_type::eof()) )
+            {
+                *this->pptr() = traits_type::to_char_type(c);
+                this->pbump(1);
+            }
+            return traits_type::not_eof(c);
+        }
+        int sync() override
+        {
+            auto len = this->pptr() - this->pbase();
+            if( len > 0 )
+            {
+                if( gzwrite(m_file, this->pbase(), static_cast<unsigned>(len)) != len )
+                    return -1;
+                this->setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+            }
+            return 0;
+        }
+    };
+
+    class GzOStream:
+        public ::std::ostream
+    {
+        GzStreamBuf m_buf;
+    public:
+        GzOStream(const ::std::string& filename):
+            ::std::ostream(nullptr),
+            m_buf(filename)
+        {
+            this->rdbuf(&m_buf);
+        }
+    };
+}
+
+bool DumpFilter::matches(const ::std::string& item_path) const
+{
+    if( this->is_all() )
+        return true;
+    return glob_match(m_glob.c_str(), item_path.c_str());
+}
+
+::std::unique_ptr<::std::ostream> DumpFile_Open(const ::std::string& filename, bool compress)
+{
+    if( compress )
+    {
+        return ::std::unique_ptr<::std::ostream>( new GzOStream(filename + ".gz") );
+    }
+    else
+    {
+        return ::std::unique_ptr<::std::ostream>( new ::std::ofstream(filename) );
+    }
+}
@@ -261,6 +261,61 @@ struct Deriver
 
         out_list.push_back(type.clone());
     }
+
+    /// Pattern that matches any value of the given variant (ignoring the fields)
+    static ::AST::Pattern get_variant_pat_nc(const AST::Path& base_path, const AST::EnumVariant& v)
+    {
+        AST::Path   var_path = base_path + v.m_name;
+
+        TU_MATCH(::AST::EnumVariantData, (v.m_data), (e),
+        (Value,
+            return AST::Pattern(AST::Pattern::TagValue(), AST::Pattern::Value::make_Named(var_path));
+            ),
+        (Tuple,
+            return AST::Pattern(AST::Pattern::TagNamedTuple(), var_path, AST::Pattern::TuplePat { {}, true, {} });
+            ),
+        (Struct,
+            return AST::Pattern(AST::Pattern::TagStruct(), var_path, {}, false);
+            )
+        )
+        throw "";
+    }
+    /// Returns true if no variant of the enum has fields
+    static bool is_fieldless(const AST::Enum& enm)
+    {
+        for(const auto& v : enm.variants())
+        {
+            if( !v.m_data.is_Value() )
+                return false;
+        }
+        return true;
+    }
+    /// Obtain the index of the variant in `*val_ref` as a `usize` (used to order/compare variants)
+    ///
+    /// Fieldless enums without explicit discriminants are a direct cast, otherwise this is a match with an arm per
+    /// variant (the index is the declaration order, not the discriminant).
+    AST::ExprNodeP get_variant_index(const Span& sp, const AST::Path& base_path, const AST::Enum& enm, AST::ExprNodeP val_ref) const
+    {
+        bool can_cast = is_fieldless(enm);
+        for(const auto& v : enm.variants())
+        {
+            if( v.m_data.is_Value() && v.m_data.as_Value().m_value.is_valid() )
+                can_cast = false;
+        }
+        if( can_cast )
+        {
+            return NEWNODE(Cast, NEWNODE(Deref, mv$(val_ref)), TypeRef(sp, CORETYPE_UINT));
+        }
+
+        ::std::vector<AST::ExprNode_Match_Arm>   arms;
+        for(unsigned int var_idx = 0; var_idx < enm.variants().size(); var_idx ++)
+        {
+            ::std::vector< AST::Pattern>    pats;
+            pats.push_back( AST::Pattern(AST::Pattern::TagReference(), false, get_variant_pat_nc(base_path, enm.variants()[var_idx])) );
+            arms.push_back(AST::ExprNode_Match_Arm( mv$(pats), nullptr, NEWNODE(Integer, var_idx, CORETYPE_UINT) ));
+        }
+        return NEWNODE(Match, mv$(val_ref), mv$(arms));
+    }
 };
 
 /// 'Debug' derive handler
@@ -539,17 +594,33 @@ public:
         base_path.nodes().back().args() = ::AST::PathParams();
         ::std::vector<AST::ExprNode_Match_Arm>   arms;
 
+        // Differing variants only need the index comparison
+        // - Fieldless enums just compare the variant indexes, empty enums have no values to compare.
+        if( enm.variants().empty() )
+        {
+            return this->make_ret(sp, core_name, p, type, {}, NEWNODE(Bool, true));
+        }
+        if( is_fieldless(enm) )
+        {
+            return this->make_ret(sp, core_name, p, type, this->get_field_bounds(enm), NEWNODE(BinOp, AST::ExprNode_BinOp::CMPEQU,
+                this->get_variant_index(sp, base_path, enm, NEWNODE(NamedValue, AST::Path("self"))),
+                this->get_variant_index(sp, base_path, enm, NEWNODE(NamedValue, AST::Path("v")))
+                ));
+        }
+
         for(const auto& v : enm.variants())
         {
+            // Fieldless variants only need the index comparison (handled by the default arm)
+            if( v.m_data.is_Value() )
+                continue ;
+
             AST::ExprNodeP  code;
             AST::Pattern    pat_a;
             AST::Pattern    pat_b;
 
             TU_MATCH(::AST::EnumVariantData, (v.m_data), (e),
             (Value,
-                code = NEWNODE(Bool, true);
-                pat_a = AST::Pattern(AST::Pattern::TagValue(), AST::Pattern::Value::make_Named(base_path + v.m_name));
-                pat_b = AST::Pattern(AST::Pattern::TagValue(), AST::Pattern::Value::make_Named(base_path + v.m_name));
+                BUG(sp, "Unreachable");
                 ),
             (Tuple,
                 ::std::vector<AST::Pattern>    pats_a;
@@ -612,22 +683,28 @@ public:
                 ));
         }
 
-        // Default arm
+        // Default arm (fieldless variants, the variant indexes are already known to be equal)
         {
             arms.push_back(AST::ExprNode_Match_Arm(
                 ::make_vec1( AST::Pattern() ),
                 nullptr,
-                NEWNODE(Bool, false)
+                NEWNODE(Bool, true)
                 ));
         }
 
+        ::std::vector<AST::ExprNodeP>   nodes;
+        nodes.push_back(this->compare_and_ret( sp, core_name,
+            this->get_variant_index(sp, base_path, enm, NEWNODE(NamedValue, AST::Path("self"))),
+            this->get_variant_index(sp, base_path, enm, NEWNODE(NamedValue, AST::Path("v")))
+            ));
         ::std::vector<AST::ExprNodeP>   vals;
         vals.push_back( NEWNODE(NamedValue, AST::Path("self")) );
         vals.push_back( NEWNODE(NamedValue, AST::Path("v")) );
-        return this->make_ret(sp, core_name, p, type, this->get_field_bounds(enm), NEWNODE(Match,
+        nodes.push_back(NEWNODE(Match,
             NEWNODE(Tuple, mv$(vals)),
             mv$(arms)
             ));
+        return this->make_ret(sp, core_name, p, type, this->get_field_bounds(enm), NEWNODE(Block, mv$(nodes)));
     }
 } g_derive_partialeq;
 
@@ -747,17 +824,35 @@ public:
         base_path.nodes().back().args() = ::AST::PathParams();
         ::std::vector<AST::ExprNode_Match_Arm>   arms;
 
+        // Variants are ordered by their index, so differing variants only need the index comparison
+        // - Fieldless enums are just that comparison, empty enums have no values to compare.
+        if( enm.variants().empty() )
+        {
+            return this->make_ret(sp, core_name, p, type, {}, this->make_ret_equal(core_name));
+        }
+        if( is_fieldless(enm) )
+        {
+            return this->make_ret(sp, core_name, p, type, this->get_field_bounds(enm), NEWNODE(CallPath, this->get_path(core_name, "cmp", "PartialOrd", "partial_cmp"),
+                ::make_vec2(
+                    NEWNODE(UniOp, AST::ExprNode_UniOp::REF, this->get_variant_index(sp, base_path, enm, NEWNODE(NamedValue, AST::Path("self")))),
+                    NEWNODE(UniOp, AST::ExprNode_UniOp::REF, this->get_variant_index(sp, base_path, enm, NEWNODE(NamedValue, AST::Path("v"))))
+                    )
+                ));
+        }
+
         for(const auto& v : enm.variants())
         {
+            // Fieldless variants only need the index comparison (handled by the default arm)
+            if( v.m_data.is_Value() )
+                continue ;
+
             AST::ExprNodeP  code;
             AST::Pattern    pat_a;
             AST::Pattern    pat_b;
 
             TU_MATCH(::AST::EnumVariantData, (v.m_data), (e),
             (Value,
-                code = this->make_ret_equal(core_name);
-                pat_a = AST::Pattern(AST::Pattern::TagValue(), AST::Pattern::Value::make_Named(base_path + v.m_name));
-                pat_b = AST::Pattern(AST::Pattern::TagValue(), AST::Pattern::Value::make_Named(base_path + v.m_name));
+                BUG(sp, "Unreachable");
                 ),
             (Tuple,
                 ::std::vector<AST::Pattern>    pats_a;
@@ -822,65 +917,26 @@ public:
                 ));
         }
 
-        // TODO: Compare the discriminants using the `discriminant_value` intrinsic
-        // - Requires a way of emitting said intrinsic into the AST
-        for(unsigned int a = 0; a < enm.variants().size(); a ++ )
-        {
-            for(unsigned int b = 0; b < enm.variants().size(); b ++ )
-            {
-                if( a == b )
-                    continue ;
-
-                struct H {
-                    static ::AST::Pattern get_pat_nc(const AST::Path& base_path, const AST::EnumVariant& v) {
-                        AST::Path   var_path = base_path + v.m_name;
-
-                        TU_MATCH(::AST::EnumVariantData, (v.m_data), (e),
-                        (Value,
-                            return AST::Pattern(AST::Pattern::TagValue(), AST::Pattern::Value::make_Named(var_path));
-                            ),
-                        (Tuple,
-                            return AST::Pattern(AST::Pattern::TagNamedTuple(), var_path, AST::Pattern::TuplePat { {}, true, {} });
-                            ),
-                        (Struct,
-                            return AST::Pattern(AST::Pattern::TagStruct(), var_path, {}, false);
-                            )
-                        )
-                        throw "";
-                    }
-                };
-                ::AST::Pattern  pat_a = H::get_pat_nc(base_path, enm.variants()[a]);
-                ::AST::Pattern  pat_b = H::get_pat_nc(base_path, enm.variants()[b]);
-
-                ::std::vector< AST::Pattern>    pats;
-                {
-                    ::std::vector< AST::Pattern>    tuple_pats;
-                    tuple_pats.push_back( AST::Pattern(AST::Pattern::TagReference(), false, mv$(pat_a)) );
-                    tuple_pats.push_back( AST::Pattern(AST::Pattern::TagReference(), false, mv$(pat_b)) );
-                    pats.push_back( AST::Pattern(AST::Pattern::TagTuple(), mv$(tuple_pats)) );
-                }
-
-                auto code = NEWNODE(CallPath, this->get_path(core_name, "option", "Option", "Some"),
-                    ::make_vec1(
-                        NEWNODE(NamedValue, this->get_path(core_name, "cmp", "Ordering", (a < b ? "Less" : "Greater")))
-                        )
-                    );
-
-                arms.push_back(AST::ExprNode_Match_Arm(
-                    mv$(pats),
-                    nullptr,
-                    mv$(code)
-                    ));
-            }
-        }
+        // Fieldless variants (the variant indexes are already known to be equal)
+        arms.push_back(AST::ExprNode_Match_Arm(
+            ::make_vec1( AST::Pattern() ),
+            nullptr,
+            this->make_ret_equal(core_name)
+            ));
 
+        ::std::vector<AST::ExprNodeP>   nodes;
+        nodes.push_back(this->make_compare_and_ret( sp, core_name,
+            this->get_variant_index(sp, base_path, enm, NEWNODE(NamedValue, AST::Path("self"))),
+            this->get_variant_index(sp, base_path, enm, NEWNODE(NamedValue, AST::Path("v")))
+            ));
         ::std::vector<AST::ExprNodeP>   vals;
         vals.push_back( NEWNODE(NamedValue, AST::Path("self")) );
         vals.push_back( NEWNODE(NamedValue, AST::Path("v")) );
-        return this->make_ret(sp, core_name, p, type, this->get_field_bounds(enm), NEWNODE(Match,
+        nodes.push_back(NEWNODE(Match,
             NEWNODE(Tuple, mv$(vals)),
             mv$(arms)
             ));
+        return this->make_ret(sp, core_name, p, type, this->get_field_bounds(enm), NEWNODE(Block, mv$(nodes)));
     }
 } g_derive_partialord;
 
@@ -1134,17 +1190,35 @@ public:
         base_path.nodes().back().args() = ::AST::PathParams();
         ::std::vector<AST::ExprNode_Match_Arm>   arms;
 
+        // Variants are ordered by their index, so differing variants only need the index comparison
+        // - Fieldless enums are just that comparison, empty enums have no values to compare.
+        if( enm.variants().empty() )
+        {
+            return this->make_ret(sp, core_name, p, type, {}, this->make_ret_equal(core_name));
+        }
+        if( is_fieldless(enm) )
+        {
+            return this->make_ret(sp, core_name, p, type, this->get_field_bounds(enm), NEWNODE(CallPath, this->get_path(core_name, "cmp", "Ord", "cmp"),
+                ::make_vec2(
+                    NEWNODE(UniOp, AST::ExprNode_UniOp::REF, this->get_variant_index(sp, base_path, enm, NEWNODE(NamedValue, AST::Path("self")))),
+                    NEWNODE(UniOp, AST::ExprNode_UniOp::REF, this->get_variant_index(sp, base_path, enm, NEWNODE(NamedValue, AST::Path("v"))))
+                    )
+                ));
+        }
+
         for(const auto& v : enm.variants())
         {
+            // Fieldless variants only need the index comparison (handled by the default arm)
+            if( v.m_data.is_Value() )
+                continue ;
+
             AST::ExprNodeP  code;
             AST::Pattern    pat_a;
             AST::Pattern    pat_b;
 
             TU_MATCH(::AST::EnumVariantData, (v.m_data), (e),
             (Value,
-                code = this->make_ret_equal(core_name);
-                pat_a = AST::Pattern(AST::Pattern::TagValue(), AST::Pattern::Value::make_Named(base_path + v.m_name));
-                pat_b = AST::Pattern(AST::Pattern::TagValue(), AST::Pattern::Value::make_Named(base_path + v.m_name));
+                BUG(sp, "Unreachable");
                 ),
             (Tuple,
                 ::std::vector<AST::Pattern>    pats_a;
@@ -1209,59 +1283,26 @@ public:
                 ));
         }
 
-        for(unsigned int a = 0; a < enm.variants().size(); a ++ )
-        {
-            for(unsigned int b = 0; b < enm.variants().size(); b ++ )
-            {
-                if( a == b )
-                    continue ;
-
-                struct H {
-                    static ::AST::Pattern get_pat_nc(const AST::Path& base_path, const AST::EnumVariant& v) {
-                        AST::Path   var_path = base_path + v.m_name;
-
-                        TU_MATCH(::AST::EnumVariantData, (v.m_data), (e),
-                        (Value,
-                            return AST::Pattern(AST::Pattern::TagValue(), AST::Pattern::Value::make_Named(var_path));
-                            ),
-                        (Tuple,
-                            return AST::Pattern(AST::Pattern::TagNamedTuple(), var_path, AST::Pattern::TuplePat { {}, true, {} });
-                            ),
-                        (Struct,
-                            return AST::Pattern(AST::Pattern::TagStruct(), var_path, {}, false);
-                            )
-                        )
-                        throw "";
-                    }
-                };
-                ::AST::Pattern  pat_a = H::get_pat_nc(base_path, enm.variants()[a]);
-                ::AST::Pattern  pat_b = H::get_pat_nc(base_path, enm.variants()[b]);
-
-                ::std::vector< AST::Pattern>    pats;
-                {
-                    ::std::vector< AST::Pattern>    tuple_pats;
-                    tuple_pats.push_back( AST::Pattern(AST::Pattern::TagReference(), false, mv$(pat_a)) );
-                    tuple_pats.push_back( AST::Pattern(AST::Pattern::TagReference(), false, mv$(pat_b)) );
-                    pats.push_back( AST::Pattern(AST::Pattern::TagTuple(), mv$(tuple_pats)) );
-                }
-
-                auto code = NEWNODE(NamedValue, this->get_path(core_name, "cmp", "Ordering", (a < b ? "Less" : "Greater")));
-
-                arms.push_back(AST::ExprNode_Match_Arm(
-                    mv$(pats),
-                    nullptr,
-                    mv$(code)
-                    ));
-            }
-        }
+        // Fieldless variants (the variant indexes are already known to be equal)
+        arms.push_back(AST::ExprNode_Match_Arm(
+            ::make_vec1( AST::Pattern() ),
+            nullptr,
+            this->make_ret_equal(core_name)
+            ));
 
+        ::std::vector<AST::ExprNodeP>   nodes;
+        nodes.push_back(this->make_compare_and_ret( sp, core_name,
+            this->get_variant_index(sp, base_path, enm, NEWNODE(NamedValue, AST::Path("self"))),
+            this->get_variant_index(sp, base_path, enm, NEWNODE(NamedValue, AST::Path("v")))
+            ));
         ::std::vector<AST::ExprNodeP>   vals;
         vals.push_back( NEWNODE(NamedValue, AST::Path("self")) );
         vals.push_back( NEWNODE(NamedValue, AST::Path("v")) );
-        return this->make_ret(sp, core_name, p, type, this->get_field_bounds(enm), NEWNODE(Match,
+        nodes.push_back(NEWNODE(Match,
             NEWNODE(Tuple, mv$(vals)),
             mv$(arms)
             ));
+        return this->make_ret(sp, core_name, p, type, this->get_field_bounds(enm), NEWNODE(Block, mv$(nodes)));
     }
 } g_derive_ord;
 
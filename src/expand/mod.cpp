@@ -15,6 +15,7 @@
 #include "../parse/common.hpp"  // For reparse from macros
 #include <ast/expr.hpp>
 #include "cfg.hpp"
+#include <profile.hpp>
 
 DecoratorDef*   g_decorators_list = nullptr;
 MacroDef*   g_macros_list = nullptr;
@@ -85,6 +86,8 @@ void Expand_Attrs(::AST::MetaItems& attrs, AttrStage stage,  ::AST::Crate& crate
     Expand_Attrs(attrs, stage,  [&](const auto& sp, const auto& d, const auto& a){ d.handle(sp, a, crate, mod, impl); });
 }
 
+// NOTE: `macro_rules!` expansion is lazy (tokens are produced as they're parsed), so callers hold the
+// `PROFILE_ITEM("macro", ...)` scope across both this call and the parse of the result.
 ::std::unique_ptr<TokenStream> Expand_Macro(
     const ::AST::Crate& crate, LList<const AST::Module*> modstack, ::AST::Module& mod,
     Span mi_span, const ::std::string& name, const ::std::string& input_ident, TokenTree& input_tt
@@ -93,7 +96,6 @@ void Expand_Attrs(::AST::MetaItems& attrs, AttrStage stage,  ::AST::Crate& crate
     if( name == "" ) {
         return ::std::unique_ptr<TokenStream>();
     }
-
     for( const auto& m : g_macros )
     {
         if( name == m.first )
@@ -156,14 +158,18 @@ void Expand_Pattern(::AST::Crate& crate, LList<const AST::Module*> modstack, ::A
     (Macro,
         const auto span = e.inv->span();
 
-        auto tt = Expand_Macro(crate, modstack, mod,  *e.inv);
-        if( ! tt ) {
-            ERROR(span, E0000, "Macro in pattern didn't expand to anything");
-        }
-        auto& lex = *tt;
-        auto newpat = Parse_Pattern(lex, is_refutable);
-        if( LOOK_AHEAD(lex) != TOK_EOF ) {
-            ERROR(span, E0000, "Trailing tokens in macro expansion");
+        ::AST::Pattern  newpat;
+        {
+            PROFILE_ITEM("macro", e.inv->name() << "!");
+            auto tt = Expand_Macro(crate, modstack, mod,  *e.inv);
+            if( ! tt ) {
+                ERROR(span, E0000, "Macro in pattern didn't expand to anything");
+            }
+            auto& lex = *tt;
+            newpat = Parse_Pattern(lex, is_refutable);
+            if( LOOK_AHEAD(lex) != TOK_EOF ) {
+                ERROR(span, E0000, "Trailing tokens in macro expansion");
+            }
         }
 
         if( pat.binding().is_valid() ) {
@@ -228,13 +234,16 @@ void Expand_Type(::AST::Crate& crate, LList<const AST::Module*> modstack, ::AST:
     (Bang,
         ),
     (Macro,
-        auto tt = Expand_Macro(crate, modstack, mod,  e.inv);
-        if(!tt)
-            ERROR(e.inv.span(), E0000, "Macro invocation didn't yeild any data");
-        auto new_ty = Parse_Type(*tt);
-        if( tt->lookahead(0) != TOK_EOF )
-            ERROR(e.inv.span(), E0000, "Extra tokens after parsed type");
-        ty = mv$(new_ty);
+        {
+            PROFILE_ITEM("macro", e.inv.name() << "!");
+            auto tt = Expand_Macro(crate, modstack, mod,  e.inv);
+            if(!tt)
+                ERROR(e.inv.span(), E0000, "Macro invocation didn't yeild any data");
+            auto new_ty = Parse_Type(*tt);
+            if( tt->lookahead(0) != TOK_EOF )
+                ERROR(e.inv.span(), E0000, "Extra tokens after parsed type");
+            ty = mv$(new_ty);
+        }
 
         Expand_Type(crate, modstack, mod,  ty);
         ),
@@ -386,6 +395,8 @@ struct CExpandExpr:
             return ::AST::ExprNodeP();
         }
 
+        PROFILE_ITEM("macro", node.m_name << "!");
+
         ::AST::ExprNodeP    rv;
         auto& mod = this->cur_mod();
         auto ttl = Expand_Macro( crate, modstack, mod,  node.span(),  node.m_name, node.m_ident, node.m_tokens );
@@ -917,6 +928,7 @@ void Expand_Impl(::AST::Crate& crate, LList<const AST::Module*> modstack, ::AST:
                 // Move out of the module to avoid invalidation if a new macro invocation is added
                 auto mi_owned = mv$(e);
 
+                PROFILE_ITEM("macro", mi_owned.name() << "!");
                 auto ttl = Expand_Macro(crate, modstack, mod, mi_owned);
 
                 if( ttl.get() )
@@ -1017,6 +1029,7 @@ void Expand_Mod(::AST::Crate& crate, LList<const AST::Module*> modstack, ::AST::
 
             TRACE_FUNCTION_F("Macro invoke " << mi_owned.name());
 
+            PROFILE_ITEM("macro", mi_owned.name() << "!");
             auto ttl = Expand_Macro(crate, modstack, mod, mi_owned);
             assert( mi_owned.name() != "");
 
@@ -31,6 +31,7 @@ namespace {
         {}
 
         ::std::string read_string() { return m_in.read_string(); }
+        RcString read_istring() { return RcString(m_in.read_string()); }
         bool read_bool() { return m_in.read_bool(); }
         size_t deserialise_count() { return m_in.read_count(); }
 
@@ -49,6 +50,21 @@ namespace {
             return rv;
         }
         template<typename V>
+        ::std::unordered_map<RcString,V> deserialise_istrumap()
+        {
+            TRACE_FUNCTION_F("<" << typeid(V).name() << ">");
+            size_t n = m_in.read_count();
+            ::std::unordered_map<RcString, V>   rv;
+            rv.reserve(n);
+            for(size_t i = 0; i < n; i ++)
+            {
+                auto s = read_istring();
+                DEBUG("- " << s);
+                rv.insert( ::std::make_pair( mv$(s), D<V>::des(*this) ) );
+            }
+            return rv;
+        }
+        template<typename V>
         ::std::unordered_map< ::std::string,V> deserialise_strumap()
         {
             TRACE_FUNCTION_F("<" << typeid(V).name() << ">");
@@ -325,6 +341,7 @@ namespace {
         ::MIR::BasicBlock deserialise_mir_basicblock();
         ::MIR::Statement deserialise_mir_statement();
         ::MIR::Terminator deserialise_mir_terminator();
+        ::MIR::SwitchValues deserialise_mir_switchvalues();
         ::MIR::CallTarget deserialise_mir_calltarget();
 
         ::MIR::Param deserialise_mir_param()
@@ -657,6 +674,9 @@ namespace {
     DEF_D( ::std::string,
         return d.read_string(); );
     template<>
+    DEF_D( RcString,
+        return d.read_istring(); );
+    template<>
     DEF_D( bool,
         return d.read_bool(); );
 
@@ -771,7 +791,7 @@ namespace {
         TRACE_FUNCTION;
         // HACK! If the read crate name is empty, replace it with the name we're loaded with
         auto crate_name = m_in.read_string();
-        auto components = deserialise_vec< ::std::string>();
+        auto components = deserialise_vec<RcString>();
         if( crate_name == "" && components.size() > 0)
         {
             assert(!m_crate_name.empty());
@@ -999,7 +1019,17 @@ namespace {
         _(BorrowPath, deserialise_path() )
         _(BorrowData, box$(deserialise_literal()) )
         _(String,  m_in.read_string() )
+        _(Repeat, {
+            box$( deserialise_literal() ),
+            m_in.read_u64()
+            })
         #undef _
+        case ::HIR::Literal::TAG_Bytes: {
+            ::std::vector<uint8_t>  bytes;
+            bytes.resize( m_in.read_count() );
+            m_in.read( bytes.data(), bytes.size() );
+            return ::HIR::Literal::make_Bytes( mv$(bytes) );
+            }
         default:
             throw "";
         }
@@ -1089,6 +1119,12 @@ namespace {
             deserialise_mir_lvalue(),
             deserialise_vec_c<unsigned int>([&](){ return static_cast<unsigned int>(m_in.read_count()); })
             })
+        _(SwitchValue, {
+            deserialise_mir_lvalue(),
+            static_cast<unsigned int>(m_in.read_count()),
+            deserialise_vec_c<unsigned int>([&](){ return static_cast<unsigned int>(m_in.read_count()); }),
+            deserialise_mir_switchvalues()
+            })
         _(Call, {
             static_cast<unsigned int>(m_in.read_count()),
             static_cast<unsigned int>(m_in.read_count()),
@@ -1102,6 +1138,22 @@ namespace {
         }
     }
 
+    ::MIR::SwitchValues HirDeserialiser::deserialise_mir_switchvalues()
+    {
+        TRACE_FUNCTION;
+
+        switch( m_in.read_tag() )
+        {
+        #define _(x, ...)    case ::MIR::SwitchValues::TAG_##x: return ::MIR::SwitchValues::make_##x( __VA_ARGS__ );
+        _(Unsigned, deserialise_vec_c<uint64_t>([&](){ return m_in.read_u64c(); }) )
+        _(Signed, deserialise_vec_c<int64_t>([&](){ return m_in.read_i64c(); }) )
+        _(String, deserialise_vec< ::std::string>() )
+        #undef _
+        default:
+            throw "";
+        }
+    }
+
     ::MIR::CallTarget HirDeserialiser::deserialise_mir_calltarget()
     {
         switch( m_in.read_tag() )
@@ -1126,8 +1178,8 @@ namespace {
         ::HIR::Module   rv;
 
         // m_traits doesn't need to be serialised
-        rv.m_value_items = deserialise_strumap< ::std::unique_ptr< ::HIR::VisEnt< ::HIR::ValueItem> > >();
-        rv.m_mod_items = deserialise_strumap< ::std::unique_ptr< ::HIR::VisEnt< ::HIR::TypeItem> > >();
+        rv.m_value_items = deserialise_istrumap< ::std::unique_ptr< ::HIR::VisEnt< ::HIR::ValueItem> > >();
+        rv.m_mod_items = deserialise_istrumap< ::std::unique_ptr< ::HIR::VisEnt< ::HIR::TypeItem> > >();
 
         return rv;
     }
@@ -1183,6 +1235,15 @@ namespace {
         rv.m_ext_libs = deserialise_vec< ::HIR::ExternLibrary>();
         rv.m_link_paths = deserialise_vec< ::std::string>();
 
+        {
+            size_t n = m_in.read_u64c();
+            for(size_t i = 0; i < n; i ++)
+            {
+                auto name = m_in.read_string();
+                rv.m_item_fingerprints.insert( ::std::make_pair( mv$(name), m_in.read_u64() ) );
+            }
+        }
+
         return rv;
     }
 }
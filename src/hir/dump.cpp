@@ -20,15 +20,25 @@ namespace {
         ::std::ostream& m_os;
         unsigned int    m_indent_level;
 
+        const DumpFilter&   m_filter;
+        // Set when within an item selected by the filter (e.g. a trait)
+        bool m_in_selected = false;
+
     public:
-        TreeVisitor(::std::ostream& os):
+        TreeVisitor(::std::ostream& os, const DumpFilter& filter):
             m_os(os),
-            m_indent_level(0)
+            m_indent_level(0),
+            m_filter(filter)
         {
         }
 
         void visit_module(::HIR::ItemPath p, ::HIR::Module& mod) override
         {
+            // When filtering, the module/impl structure isn't printed (selected items are prefixed by their path)
+            if( !m_filter.is_all() ) {
+                ::HIR::Visitor::visit_module(p, mod);
+                return ;
+            }
             if( p.get_name()[0] )
             {
                 m_os << indent() << "mod " << p.get_name() << " {\n";
@@ -47,6 +57,10 @@ namespace {
 
         void visit_type_impl(::HIR::TypeImpl& impl) override
         {
+            if( !m_filter.is_all() ) {
+                ::HIR::Visitor::visit_type_impl(impl);
+                return ;
+            }
             m_os << indent() << "impl" << impl.m_params.fmt_args() << " " << impl.m_type << "\n";
             if( ! impl.m_params.m_bounds.empty() )
             {
@@ -60,6 +74,10 @@ namespace {
         }
         virtual void visit_trait_impl(const ::HIR::SimplePath& trait_path, ::HIR::TraitImpl& impl) override
         {
+            if( !m_filter.is_all() ) {
+                ::HIR::Visitor::visit_trait_impl(trait_path, impl);
+                return ;
+            }
             m_os << indent() << "impl" << impl.m_params.fmt_args() << " " << trait_path << impl.m_trait_args << " for " << impl.m_type << "\n";
             if( ! impl.m_params.m_bounds.empty() )
             {
@@ -73,6 +91,8 @@ namespace {
         }
         void visit_marker_impl(const ::HIR::SimplePath& trait_path, ::HIR::MarkerImpl& impl) override
         {
+            if( !m_filter.is_all() )
+                return ;
             m_os << indent() << "impl" << impl.m_params.fmt_args() << " " << (impl.is_positive ? "" : "!") << trait_path << impl.m_trait_args << " for " << impl.m_type << "\n";
             if( ! impl.m_params.m_bounds.empty() )
             {
@@ -84,10 +104,16 @@ namespace {
         // - Type Items
         void visit_type_alias(::HIR::ItemPath p, ::HIR::TypeAlias& item) override
         {
+            if( !this->select_item(p) )
+                return ;
             m_os << indent() << "type " << p.get_name() << item.m_params.fmt_args() << " = " << item.m_type << item.m_params.fmt_bounds() << "\n";
         }
         void visit_trait(::HIR::ItemPath p, ::HIR::Trait& item) override
         {
+            if( !this->select_item(p) )
+                return ;
+            auto saved_in_selected = m_in_selected;
+            m_in_selected = true;
             m_os << indent() << "trait " << p.get_name() << item.m_params.fmt_args() << "\n";
             if( ! item.m_params.m_bounds.empty() )
             {
@@ -98,9 +124,12 @@ namespace {
             ::HIR::Visitor::visit_trait(p, item);
             dec_indent();
             m_os << indent() << "}\n";
+            m_in_selected = saved_in_selected;
         }
         void visit_struct(::HIR::ItemPath p, ::HIR::Struct& item) override
         {
+            if( !this->select_item(p) )
+                return ;
             m_os << indent() << "struct " << p.get_name() << item.m_params.fmt_args();
             TU_MATCHA( (item.m_data), (flds),
             (Unit,
@@ -151,6 +180,8 @@ namespace {
         }
         void visit_enum(::HIR::ItemPath p, ::HIR::Enum& item) override
         {
+            if( !this->select_item(p) )
+                return ;
             m_os << indent() << "enum " << p.get_name() << item.m_params.fmt_args() << "\n";
             if( ! item.m_params.m_bounds.empty() )
             {
@@ -188,6 +219,8 @@ namespace {
         // - Value Items
         void visit_function(::HIR::ItemPath p, ::HIR::Function& item) override
         {
+            if( !this->select_item(p) )
+                return ;
             m_os << indent();
             if( item.m_const )
                 m_os << "const ";
@@ -233,6 +266,8 @@ namespace {
         }
         void visit_static(::HIR::ItemPath p, ::HIR::Static& item) override
         {
+            if( !this->select_item(p) )
+                return ;
             if( item.m_linkage.name != "" )
                 m_os << indent() << "#[link_name=\"" << item.m_linkage.name << "\"]\n";
             if( item.m_value )
@@ -250,6 +285,8 @@ namespace {
         }
         void visit_constant(::HIR::ItemPath p, ::HIR::Constant& item) override
         {
+            if( !this->select_item(p) )
+                return ;
             m_os << indent() << "const " << p.get_name() << ": " << item.m_type << " = " << item.m_value_res;
             if( item.m_value )
             {
@@ -687,6 +724,17 @@ namespace {
         }
 
     private:
+        /// Check if an item is to be printed (printing its path if only some items are selected)
+        bool select_item(const ::HIR::ItemPath& p) {
+            if( m_filter.is_all() || m_in_selected )
+                return true;
+            auto path = FMT(p);
+            if( !m_filter.matches(path) )
+                return false;
+            m_os << indent() << "// " << path << "\n";
+            return true;
+        }
+
         RepeatLitStr indent() const {
             return RepeatLitStr { "    ", static_cast<int>(m_indent_level) };
         }
@@ -699,9 +747,9 @@ namespace {
     };
 }
 
-void HIR_Dump(::std::ostream& sink, const ::HIR::Crate& crate)
+void HIR_Dump(::std::ostream& sink, const ::HIR::Crate& crate, const DumpFilter& filter)
 {
-    TreeVisitor tv { sink };
+    TreeVisitor tv { sink, filter };
 
     tv.visit_crate( const_cast< ::HIR::Crate&>(crate) );
 }
@@ -6,6 +6,102 @@
  * - HIR expression helper code
  */
 #include <hir/expr.hpp>
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <new>
+
+namespace HIR {
+    /// Arena for the nodes of one expression tree
+    ///
+    /// Nodes are carved out of large chunks (no per-node allocator overhead, and nodes of a function end up close
+    /// together). Individual frees only drop a reference, the chunks are all released once the arena's scope has
+    /// ended and every node allocated from it has been freed (e.g. by `ExprPtr::release_hir`).
+    class ExprArena
+    {
+        static const size_t ALIGN = alignof(::std::max_align_t);
+        static const size_t CHUNK_SIZE = 64*1024;
+
+        ::std::vector<char*>    m_chunks;
+        char*   m_chunk_pos = nullptr;
+        char*   m_chunk_end = nullptr;
+        // Live nodes, plus one for the owning scope
+        ::std::atomic<size_t>   m_refcount { 1 };
+    public:
+        ExprArena() {}
+        ExprArena(const ExprArena&) = delete;
+        ~ExprArena()
+        {
+            for(auto* c : m_chunks)
+                ::operator delete(c);
+        }
+
+        // NOTE: Only called by the thread that owns the scope
+        void* allocate(size_t size)
+        {
+            size = (size + ALIGN - 1) / ALIGN * ALIGN;
+            m_refcount ++;
+            if( size > CHUNK_SIZE / 4 )
+            {
+                m_chunks.push_back( static_cast<char*>(::operator new(size)) );
+                return m_chunks.back();
+            }
+            if( static_cast<size_t>(m_chunk_end - m_chunk_pos) < size )
+            {
+                m_chunks.push_back( static_cast<char*>(::operator new(CHUNK_SIZE)) );
+                m_chunk_pos = m_chunks.back();
+                m_chunk_end = m_chunk_pos + CHUNK_SIZE;
+            }
+            void* rv = m_chunk_pos;
+            m_chunk_pos += size;
+            return rv;
+        }
+        /// Drop a reference (a freed node, or the end of the scope), the last one frees the arena
+        void release()
+        {
+            if( --m_refcount == 0 )
+                delete this;
+        }
+    };
+}
+
+namespace {
+    /// Arena new nodes on this thread are allocated from (null outside an `ExprArenaScope`)
+    thread_local ::HIR::ExprArena*  s_current_arena = nullptr;
+
+    /// Prefixed to each node, so it can be returned to the right arena (or the heap) when freed
+    struct alignas(::std::max_align_t) NodeHeader {
+        ::HIR::ExprArena*   arena;
+    };
+}
+
+::HIR::ExprArenaScope::ExprArenaScope():
+    m_arena(new ExprArena()),
+    m_prev(s_current_arena)
+{
+    s_current_arena = m_arena;
+}
+::HIR::ExprArenaScope::~ExprArenaScope()
+{
+    s_current_arena = m_prev;
+    m_arena->release();
+}
+
+void* ::HIR::ExprNode::operator new(size_t size)
+{
+    auto* arena = s_current_arena;
+    void* mem = arena ? arena->allocate(sizeof(NodeHeader) + size) : ::operator new(sizeof(NodeHeader) + size);
+    auto* hdr = new(mem) NodeHeader { arena };
+    return hdr + 1;
+}
+void ::HIR::ExprNode::operator delete(void* ptr, size_t size)
+{
+    auto* hdr = static_cast<NodeHeader*>(ptr) - 1;
+    if( hdr->arena )
+        hdr->arena->release();
+    else
+        ::operator delete(hdr);
+}
 
 ::HIR::ExprNode::~ExprNode()
 {
@@ -56,6 +56,26 @@ public:
         m_res_type( mv$(ty) )
     {}
     virtual ~ExprNode();
+
+    // Nodes are allocated from the current `ExprArenaScope` (see expr.cpp), as there are a very large number of small nodes
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr, size_t size);
+};
+
+class ExprArena;
+/// While in scope, expression nodes created on this thread are allocated from a new arena
+///
+/// The arena is released in one go once the scope has ended and all of its nodes have been freed. Nodes created
+/// outside of any scope use the general heap.
+class ExprArenaScope
+{
+    ExprArena*  m_arena;
+    ExprArena*  m_prev;
+public:
+    ExprArenaScope();
+    ExprArenaScope(const ExprArenaScope&) = delete;
+    ExprArenaScope& operator=(const ExprArenaScope&) = delete;
+    ~ExprArenaScope();
 };
 
 typedef ::std::unique_ptr<ExprNode> ExprNodeP;
@@ -16,6 +16,12 @@
 {
     return node.into_unique();
 }
+void HIR::ExprPtr::release_hir()
+{
+    assert(m_mir);
+    node.reset(nullptr);
+    m_hir_released = true;
+}
 
 
 ::HIR::ExprPtrInner::ExprPtrInner(::std::unique_ptr< ::HIR::ExprNode> v):
@@ -57,6 +57,7 @@ public:
 class ExprPtr
 {
     ::HIR::ExprPtrInner node;
+    bool    m_hir_released = false;
 
 public:
     ::std::vector< ::HIR::TypeRef>  m_bindings;
@@ -72,6 +73,11 @@ public:
     ::HIR::ExprNode* get() const { return node.get(); }
     void reset(::HIR::ExprNode* p) { node.reset(p); }
 
+    /// Free the expression tree once it has been lowered to MIR (the MIR and erased types are kept)
+    void release_hir();
+    /// True for code from the current crate (the tree is present, or was freed by `release_hir`)
+    bool is_local() const { return node || m_hir_released; }
+
           ::HIR::ExprNode& operator*()       { return *node; }
     const ::HIR::ExprNode& operator*() const { return *node; }
           ::HIR::ExprNode* operator->()       { return &*node; }
@@ -711,5 +711,7 @@ struct LowerHIR_ExprNode_Visitor:
 
 ::HIR::ExprPtr LowerHIR_ExprNode(const ::AST::ExprNode& e)
 {
+    // Each body gets its own arena, freed along with the body
+    ::HIR::ExprArenaScope   arena;
     return ::HIR::ExprPtr( LowerHIR_ExprNode_Inner(e) );
 }
@@ -41,6 +41,20 @@ namespace HIR {
             ),
         (String,
             os << "\"" << e << "\"";
+            ),
+        (Repeat,
+            os << "[" << *e.val << "; " << e.count << "]";
+            ),
+        (Bytes,
+            os << "b\"";
+            for(auto b : e)
+            {
+                if( ' ' <= b && b < 0x7F && b != '"' && b != '\\' )
+                    os << static_cast<char>(b);
+                else
+                    os << "\\x" << "0123456789ABCDEF"[b >> 4] << "0123456789ABCDEF"[b & 15];
+            }
+            os << "\"";
             )
         )
         return os;
@@ -78,11 +92,114 @@ namespace HIR {
             return *le == *re;
             ),
         (String,
+            return le == re;
+            ),
+        (Repeat,
+            return le.count == re.count && *le.val == *re.val;
+            ),
+        (Bytes,
             return le == re;
             )
         )
         return true;
     }
+
+    size_t Literal::list_size() const
+    {
+        TU_MATCH_DEF(::HIR::Literal, (*this), (e),
+        (
+            BUG(Span(), "list_size on non-array literal - " << *this);
+            ),
+        (List,
+            return e.size();
+            ),
+        (Repeat,
+            return e.count;
+            ),
+        (Bytes,
+            return e.size();
+            )
+        )
+        throw "";
+    }
+    void Literal::expand_list()
+    {
+        if( this->is_Repeat() )
+        {
+            auto& e = this->as_Repeat();
+            ::std::vector<Literal>  vals;
+            vals.reserve(e.count);
+            for(uint64_t i = 1; i < e.count; i ++)
+                vals.push_back( e.val->clone() );
+            if( e.count > 0 )
+                vals.push_back( mv$(*e.val) );
+            *this = Literal::make_List( mv$(vals) );
+        }
+        else if( this->is_Bytes() )
+        {
+            ::std::vector<Literal>  vals;
+            vals.reserve(this->as_Bytes().size());
+            for(auto b : this->as_Bytes())
+                vals.push_back( Literal::make_Integer(b) );
+            *this = Literal::make_List( mv$(vals) );
+        }
+    }
+    void Literal::pack_bytes()
+    {
+        if( !this->is_List() || this->as_List().empty() )
+            return ;
+        const auto& vals = this->as_List();
+        ::std::vector<uint8_t>  bytes;
+        bytes.reserve(vals.size());
+        for(const auto& v : vals)
+        {
+            if( !v.is_Integer() )
+                return ;
+            bytes.push_back( static_cast<uint8_t>(v.as_Integer()) );
+        }
+        *this = Literal::make_Bytes( mv$(bytes) );
+    }
+    Literal Literal::clone() const
+    {
+        TU_MATCH(::HIR::Literal, (*this), (e),
+        (Invalid,
+            return ::HIR::Literal();
+            ),
+        (List,
+            ::std::vector< ::HIR::Literal>  vals;
+            vals.reserve(e.size());
+            for(const auto& val : e) {
+                vals.push_back( val.clone() );
+            }
+            return ::HIR::Literal( mv$(vals) );
+            ),
+        (Variant,
+            return ::HIR::Literal::make_Variant({ e.idx, box$(e.val->clone()) });
+            ),
+        (Integer,
+            return ::HIR::Literal(e);
+            ),
+        (Float,
+            return ::HIR::Literal(e);
+            ),
+        (BorrowPath,
+            return ::HIR::Literal(e.clone());
+            ),
+        (BorrowData,
+            return ::HIR::Literal(box$( e->clone() ));
+            ),
+        (String,
+            return ::HIR::Literal(e);
+            ),
+        (Repeat,
+            return ::HIR::Literal::make_Repeat({ box$(e.val->clone()), e.count });
+            ),
+        (Bytes,
+            return ::HIR::Literal(e);
+            )
+        )
+        throw "";
+    }
 }
 
 size_t ::HIR::Enum::find_variant(const ::std::string& name) const
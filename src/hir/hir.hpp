@@ -47,10 +47,10 @@ struct VisEnt
 
 /// Literal type used for constant evaluation
 /// NOTE: Intentionally minimal, just covers the values (not the types)
-TAGGED_UNION(Literal, Invalid,
+TAGGED_UNION_EX(Literal, (), Invalid, (
     (Invalid, struct {}),
     // List = Array, Tuple, struct literal
-    (List, ::std::vector<Literal>), // TODO: Have a variant for repetition lists
+    (List, ::std::vector<Literal>),
     // Variant = Enum variant
     (Variant, struct {
         unsigned int    idx;
@@ -64,7 +64,24 @@ TAGGED_UNION(Literal, Invalid,
     // Borrow of inline data
     (BorrowData, ::std::unique_ptr<Literal>),
     // String = &'static str or &[u8; N]
-    (String, ::std::string)
+    (String, ::std::string),
+    // Repeat = `[val; count]` array, stored once instead of `count` copies
+    (Repeat, struct {
+        ::std::unique_ptr<Literal> val;
+        uint64_t    count;
+        }),
+    // Bytes = `[u8; N]` array, packed instead of one Integer per element
+    (Bytes, ::std::vector<uint8_t>)
+    ), (), (), (
+        /// Number of entries in an array literal (List, Repeat, or Bytes)
+        size_t list_size() const;
+        /// Convert a Repeat or Bytes literal into the equivalent List (no-op for other variants)
+        /// - Used before an individual element is accessed or modified
+        void expand_list();
+        /// Convert a List of Integers into Bytes (caller must ensure that the element type is `u8`)
+        void pack_bytes();
+        Literal clone() const;
+    )
     );
 extern ::std::ostream& operator<<(::std::ostream& os, const Literal& v);
 extern bool operator==(const Literal& l, const Literal& r);
@@ -338,9 +355,9 @@ public:
     ::std::vector< ::HIR::SimplePath>   m_traits;
 
     // Contains all values and functions (including type constructors)
-    ::std::unordered_map< ::std::string, ::std::unique_ptr<VisEnt<ValueItem>> > m_value_items;
+    ::std::unordered_map< RcString, ::std::unique_ptr<VisEnt<ValueItem>> > m_value_items;
     // Contains types, traits, and modules
-    ::std::unordered_map< ::std::string, ::std::unique_ptr<VisEnt<TypeItem>> > m_mod_items;
+    ::std::unordered_map< RcString, ::std::unique_ptr<VisEnt<TypeItem>> > m_mod_items;
 
     Module() {}
     Module(const Module&) = delete;
@@ -479,6 +496,10 @@ public:
     ::std::vector<ExternLibrary>    m_ext_libs;
     ::std::vector<::std::string>    m_link_paths;
 
+    /// Fingerprints of each item (and impl) in the metadata this crate was loaded from, keyed by a description of the item
+    /// - Only populated for loaded crates (see hir/serialise.cpp)
+    ::std::map< ::std::string, uint64_t>    m_item_fingerprints;
+
     /// Method called to populate runtime state after deserialisation
     /// See hir/crate_post_load.cpp
     void post_load_update(const ::std::string& loaded_name);
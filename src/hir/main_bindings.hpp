@@ -10,12 +10,13 @@
 #include "crate_ptr.hpp"
 #include <iostream>
 #include <string>
+#include <dump_filter.hpp>
 
 namespace AST {
     class Crate;
 }
 
-extern void HIR_Dump(::std::ostream& sink, const ::HIR::Crate& crate);
+extern void HIR_Dump(::std::ostream& sink, const ::HIR::Crate& crate, const DumpFilter& filter);
 extern ::HIR::CratePtr  LowerHIR_FromAST(::AST::Crate crate);
 extern void HIR_Serialise(const ::std::string& filename, const ::HIR::Crate& crate);
 extern ::HIR::CratePtr HIR_Deserialise(const ::std::string& filename, const ::std::string& loaded_name);
@@ -11,16 +11,35 @@
 #include <macro_rules/macro_rules.hpp>
 #include <mir/mir.hpp>
 #include "serialise_lowlevel.hpp"
+#include <cstdio>  // rename/remove
+#include <algorithm>
 
 namespace {
     class HirSerialiser
     {
         ::HIR::serialise::Writer&   m_out;
+
+        /// Path of the module item currently being serialised
+        ::std::string   m_item_path;
+        /// Per-item fingerprints, written after the crate
+        ::std::map< ::std::string, uint64_t>    m_fingerprints;
     public:
         HirSerialiser(::HIR::serialise::Writer& out):
             m_out( out )
         {}
 
+        /// Entries of an unordered map sorted by key, so the output doesn't depend on hashing (or interning) order
+        template<typename M>
+        static ::std::vector<const typename M::value_type*> sorted_entries(const M& map)
+        {
+            ::std::vector<const typename M::value_type*>   rv;
+            rv.reserve(map.size());
+            for(const auto& v : map)
+                rv.push_back(&v);
+            ::std::stable_sort(rv.begin(), rv.end(), [](const auto* a, const auto* b){ return a->first < b->first; });
+            return rv;
+        }
+
         template<typename V>
         void serialise_strmap(const ::std::map< ::std::string,V>& map)
         {
@@ -30,24 +49,24 @@ namespace {
                 serialise(v.second);
             }
         }
-        template<typename V>
-        void serialise_strmap(const ::std::unordered_map< ::std::string,V>& map)
+        template<typename K, typename V>
+        void serialise_strmap(const ::std::unordered_map<K,V>& map)
         {
             m_out.write_count(map.size());
-            for(const auto& v : map) {
-                DEBUG("- " << v.first);
-                m_out.write_string(v.first);
-                serialise(v.second);
+            for(const auto* v : sorted_entries(map)) {
+                DEBUG("- " << v->first);
+                m_out.write_string(v->first);
+                serialise(v->second);
             }
         }
         template<typename V>
         void serialise_strmap(const ::std::unordered_multimap< ::std::string,V>& map)
         {
             m_out.write_count(map.size());
-            for(const auto& v : map) {
-                DEBUG("- " << v.first);
-                m_out.write_string(v.first);
-                serialise(v.second);
+            for(const auto* v : sorted_entries(map)) {
+                DEBUG("- " << v->first);
+                m_out.write_string(v->first);
+                serialise(v->second);
             }
         }
         template<typename T>
@@ -239,35 +258,62 @@ namespace {
 
         void serialise_crate(const ::HIR::Crate& crate)
         {
+            // Everything in the metadata is visible to dependent crates (function bodies are only saved when they're
+            // needed downstream), so the interface hash covers all of it.
+            m_out.open_hash();
+
             m_out.write_string(crate.m_crate_name);
             serialise_module(crate.m_root_module);
 
             m_out.write_count(crate.m_type_impls.size());
-            for(const auto& impl : crate.m_type_impls) {
+            for(size_t i = 0; i < crate.m_type_impls.size(); i ++) {
+                const auto& impl = crate.m_type_impls[i];
+                m_out.open_hash();
                 serialise_typeimpl(impl);
+                m_fingerprints[FMT("impl#" << i << " " << impl.m_type)] = m_out.close_hash();
             }
             m_out.write_count(crate.m_trait_impls.size());
+            size_t i = 0;
             for(const auto& tr_impl : crate.m_trait_impls) {
+                m_out.open_hash();
                 serialise_simplepath(tr_impl.first);
                 serialise_traitimpl(tr_impl.second);
+                m_fingerprints[FMT("impl#" << i++ << " " << tr_impl.first << " for " << tr_impl.second.m_type)] = m_out.close_hash();
             }
             m_out.write_count(crate.m_marker_impls.size());
             for(const auto& tr_impl : crate.m_marker_impls) {
+                m_out.open_hash();
                 serialise_simplepath(tr_impl.first);
                 serialise_markerimpl(tr_impl.second);
+                m_fingerprints[FMT("impl#" << i++ << " " << tr_impl.first << " for " << tr_impl.second.m_type)] = m_out.close_hash();
             }
 
-            serialise_strmap(crate.m_exported_macros);
+            m_out.write_count(crate.m_exported_macros.size());
+            for(const auto* v : sorted_entries(crate.m_exported_macros)) {
+                m_out.open_hash();
+                m_out.write_string(v->first);
+                serialise(v->second);
+                m_fingerprints[FMT("macro " << v->first)] = m_out.close_hash();
+            }
             serialise_strmap(crate.m_lang_items);
 
             m_out.write_count(crate.m_ext_crates.size());
-            for(const auto& ext : crate.m_ext_crates)
+            for(const auto* ext : sorted_entries(crate.m_ext_crates))
             {
-                m_out.write_string(ext.first);
-                m_out.write_string(ext.second.m_basename);
+                m_out.write_string(ext->first);
+                m_out.write_string(ext->second.m_basename);
             }
             serialise_vec(crate.m_ext_libs);
             serialise_vec(crate.m_link_paths);
+
+            m_out.set_interface_hash( m_out.close_hash() );
+
+            m_out.write_u64c(m_fingerprints.size());
+            for(const auto& fp : m_fingerprints)
+            {
+                m_out.write_string(fp.first);
+                m_out.write_u64(fp.second);
+            }
         }
         void serialise(const ::HIR::ExternLibrary& lib)
         {
@@ -279,8 +325,27 @@ namespace {
 
             // m_traits doesn't need to be serialised
 
-            serialise_strmap(mod.m_value_items);
-            serialise_strmap(mod.m_mod_items);
+            serialise_module_items("value", mod.m_value_items);
+            serialise_module_items("type", mod.m_mod_items);
+        }
+        /// Serialise one namespace of a module, recording a fingerprint for each item
+        template<typename V>
+        void serialise_module_items(const char* ns, const ::std::unordered_map<RcString, V>& map)
+        {
+            m_out.write_count(map.size());
+            for(const auto* v : sorted_entries(map))
+            {
+                auto parent_len = m_item_path.size();
+                m_item_path += "::";
+                m_item_path += v->first.str();
+
+                m_out.open_hash();
+                m_out.write_string(v->first);
+                serialise(v->second);
+                m_fingerprints[FMT(ns << " " << m_item_path)] = m_out.close_hash();
+
+                m_item_path.resize(parent_len);
+            }
         }
         void serialise_typeimpl(const ::HIR::TypeImpl& impl)
         {
@@ -361,6 +426,9 @@ namespace {
         void serialise(const ::std::string& v) {
             m_out.write_string(v);
         }
+        void serialise(const RcString& v) {
+            m_out.write_string(v);
+        }
 
         void serialise(const ::MacroRulesPtr& mac)
         {
@@ -452,6 +520,14 @@ namespace {
                 ),
             (String,
                 m_out.write_string(e);
+                ),
+            (Repeat,
+                serialise(*e.val);
+                m_out.write_u64(e.count);
+                ),
+            (Bytes,
+                m_out.write_count(e.size());
+                m_out.write( e.data(), e.size() );
                 )
             )
         }
@@ -561,10 +637,14 @@ namespace {
             m_out.write_tag( static_cast<int>(sv.tag()) );
             TU_MATCHA( (sv), (e),
             (Unsigned,
-                serialise_vec(e);
+                m_out.write_count(e.size());
+                for(auto v : e)
+                    m_out.write_u64c(v);
                 ),
             (Signed,
-                serialise_vec(e);
+                m_out.write_count(e.size());
+                for(auto v : e)
+                    m_out.write_i64c(v);
                 ),
             (String,
                 serialise_vec(e);
@@ -985,8 +1065,18 @@ namespace {
 
 void HIR_Serialise(const ::std::string& filename, const ::HIR::Crate& crate)
 {
-    ::HIR::serialise::Writer    out { filename };
-    HirSerialiser  s { out };
-    s.serialise_crate(crate);
+    // Write to a temporary file and rename into place, so the output only exists once it's complete (build tools
+    // start dependent crates as soon as the metadata appears)
+    auto tmp_filename = filename + ".tmp";
+    {
+        ::HIR::serialise::Writer    out { tmp_filename };
+        HirSerialiser  s { out };
+        s.serialise_crate(crate);
+    }
+    ::std::remove(filename.c_str());
+    if( ::std::rename(tmp_filename.c_str(), filename.c_str()) != 0 )
+    {
+        ERROR(Span(), E0000, "Unable to rename " << tmp_filename << " to " << filename);
+    }
 }
 
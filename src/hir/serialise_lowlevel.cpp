@@ -23,6 +23,8 @@ class WriterInner
     unsigned int    m_byte_out_count = 0;
     unsigned int    m_byte_in_count = 0;
 public:
+    uint64_t    m_interface_hash = 0;
+
     WriterInner(const ::std::string& filename);
     ~WriterInner();
     void write(const void* buf, size_t len);
@@ -38,8 +40,21 @@ Writer::~Writer()
 }
 void Writer::write(const void* buf, size_t len)
 {
+    for(auto& h : m_hashes)
+    {
+        const auto* p = reinterpret_cast<const uint8_t*>(buf);
+        for(size_t i = 0; i < len; i ++)
+        {
+            h ^= p[i];
+            h *= 0x100000001b3;
+        }
+    }
     m_inner->write(buf, len);
 }
+void Writer::set_interface_hash(uint64_t v)
+{
+    m_inner->m_interface_hash = v;
+}
 
 
 WriterInner::WriterInner(const ::std::string& filename):
@@ -59,6 +74,11 @@ WriterInner::WriterInner(const ::std::string& filename):
 
     m_zstream.avail_out = m_buffer.size();
     m_zstream.next_out = m_buffer.data();
+
+    // Header, the interface hash is filled in once the crate has been written
+    uint8_t header[FILE_HEADER_SIZE] = { 0 };
+    memcpy(header, FILE_MAGIC, sizeof(FILE_MAGIC));
+    m_backing.write( reinterpret_cast<char*>(header), sizeof(header) );
 }
 WriterInner::~WriterInner()
 {
@@ -84,6 +104,12 @@ WriterInner::~WriterInner()
         }
     } while(ret == Z_OK);
     deflateEnd(&m_zstream);
+
+    uint8_t hash_bytes[8];
+    for(int i = 0; i < 8; i ++)
+        hash_bytes[i] = static_cast<uint8_t>(m_interface_hash >> (i * 8));
+    m_backing.seekp( sizeof(FILE_MAGIC) );
+    m_backing.write( reinterpret_cast<char*>(hash_bytes), sizeof(hash_bytes) );
 }
 
 void WriterInner::write(const void* buf, size_t len)
@@ -224,6 +250,11 @@ ReaderInner::ReaderInner(const ::std::string& filename):
     if( !m_backing.is_open() )
         throw ::std::runtime_error("Unable to open file");
 
+    char header[FILE_HEADER_SIZE];
+    m_backing.read(header, sizeof(header));
+    if( m_backing.gcount() != sizeof(header) || memcmp(header, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 )
+        throw ::std::runtime_error("Not a metadata file (or written by an incompatible version of mrustc)");
+
     m_zstream.zalloc = Z_NULL;
     m_zstream.zfree = Z_NULL;
     m_zstream.opaque = Z_NULL;
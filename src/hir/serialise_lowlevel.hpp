@@ -18,9 +18,18 @@ namespace serialise {
 class WriterInner;
 class ReaderInner;
 
+/// Metadata files start with an uncompressed header, so build tools can read the interface hash without loading the crate
+/// - 8 byte magic (`FILE_MAGIC`)
+/// - 64-bit little-endian interface hash (see `HIR_Serialise`)
+/// The rest of the file is the zlib-compressed crate.
+static const char FILE_MAGIC[8] = { 'M','R','S','H','I','R','0','1' };
+static const size_t FILE_HEADER_SIZE = 16;
+
 class Writer
 {
     WriterInner*    m_inner;
+    /// Active fingerprints (FNV-1a of the uncompressed data), innermost last
+    ::std::vector<uint64_t> m_hashes;
 public:
     Writer(const ::std::string& path);
     Writer(const Writer&) = delete;
@@ -29,6 +38,20 @@ public:
 
     void write(const void* data, size_t count);
 
+    /// Start fingerprinting everything written until the matching `close_hash` (fingerprints can nest)
+    void open_hash() {
+        m_hashes.push_back(0xcbf29ce484222325);
+    }
+    /// End the innermost fingerprint and return its value
+    uint64_t close_hash() {
+        assert(!m_hashes.empty());
+        auto rv = m_hashes.back();
+        m_hashes.pop_back();
+        return rv;
+    }
+    /// Set the interface hash stored in the file header
+    void set_interface_hash(uint64_t v);
+
     void write_u8(uint8_t v) {
         write(reinterpret_cast<const char*>(&v), 1);
     }
@@ -132,6 +132,11 @@ namespace {
                 visit_literal(sp, *e);
                 ),
             (String,
+                ),
+            (Repeat,
+                visit_literal(sp, *e.val);
+                ),
+            (Bytes,
                 )
             )
         }
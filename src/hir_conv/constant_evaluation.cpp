@@ -49,41 +49,6 @@ namespace {
 
     ::HIR::Literal evaluate_constant(const Span& sp, const ::HIR::Crate& crate, NewvalState newval_state, const ::HIR::ExprPtr& expr, ::HIR::TypeRef exp, ::std::vector< ::HIR::Literal> args={});
 
-    ::HIR::Literal clone_literal(const ::HIR::Literal& v)
-    {
-        TU_MATCH(::HIR::Literal, (v), (e),
-        (Invalid,
-            return ::HIR::Literal();
-            ),
-        (List,
-            ::std::vector< ::HIR::Literal>  vals;
-            for(const auto& val : e) {
-                vals.push_back( clone_literal(val) );
-            }
-            return ::HIR::Literal( mv$(vals) );
-            ),
-        (Variant,
-            return ::HIR::Literal::make_Variant({ e.idx, box$(clone_literal(*e.val)) });
-            ),
-        (Integer,
-            return ::HIR::Literal(e);
-            ),
-        (Float,
-            return ::HIR::Literal(e);
-            ),
-        (BorrowPath,
-            return ::HIR::Literal(e.clone());
-            ),
-        (BorrowData,
-            return ::HIR::Literal(box$( clone_literal(*e) ));
-            ),
-        (String,
-            return ::HIR::Literal(e);
-            )
-        )
-        throw "";
-    }
-
     TAGGED_UNION(EntPtr, NotFound,
         (NotFound, struct{}),
         (Function, const ::HIR::Function*),
@@ -537,6 +502,7 @@ namespace {
                 // Value
                 m_exp_type = ::HIR::TypeRef::new_slice( mv$(exp_ty) );
                 node.m_value->visit(*this);
+                m_rv.expand_list();
                 if( !m_rv.is_List() )
                     ERROR(node.span(), E0000, "Indexed value isn't a list - got " << m_rv.tag_str());
                 auto v = mv$( m_rv.as_List() );
@@ -797,7 +763,7 @@ namespace {
                         const_cast<HIR::ExprNode&>(*c.m_value).visit(*this);
                     }
                     else {
-                        m_rv = clone_literal(c.m_value_res);
+                        m_rv = c.m_value_res.clone();
                     }
                     m_rv_type = e->m_type.clone();
                     )
@@ -948,8 +914,10 @@ namespace {
                     vals.push_back( mv$(m_rv) );
                 }
 
-                m_rv_type = ::HIR::TypeRef::new_array( mv$(m_rv_type), vals.size() );
                 m_rv = ::HIR::Literal::make_List(mv$(vals));
+                if( m_rv_type == ::HIR::CoreType::U8 )
+                    m_rv.pack_bytes();
+                m_rv_type = ::HIR::TypeRef::new_array( mv$(m_rv_type), m_rv.list_size() );
             }
             void visit(::HIR::ExprNode_ArraySized& node) override
             {
@@ -973,20 +941,25 @@ namespace {
                 assert( m_rv.is_Integer() );
                 unsigned int count = static_cast<unsigned int>(m_rv.as_Integer());
 
-                ::std::vector< ::HIR::Literal>  vals;
-                vals.reserve( count );
-                if( count > 0 )
+                if( count > 1 )
                 {
                     m_exp_type = mv$(exp_inner_ty);
                     node.m_val->visit(*this);
                     assert( !m_rv.is_Invalid() );
-                    for(unsigned int i = 0; i < count-1; i ++)
+                    m_rv = ::HIR::Literal::make_Repeat({ box$(m_rv), count });
+                }
+                else
+                {
+                    ::std::vector< ::HIR::Literal>  vals;
+                    if( count > 0 )
                     {
-                        vals.push_back( clone_literal(m_rv) );
+                        m_exp_type = mv$(exp_inner_ty);
+                        node.m_val->visit(*this);
+                        assert( !m_rv.is_Invalid() );
+                        vals.push_back( mv$(m_rv) );
                     }
-                    vals.push_back( mv$(m_rv) );
+                    m_rv = ::HIR::Literal::make_List(mv$(vals));
                 }
-                m_rv = ::HIR::Literal::make_List(mv$(vals));
                 m_rv_type = ::HIR::TypeRef::new_array( mv$(m_rv_type), count );
             }
 
@@ -1092,7 +1065,7 @@ namespace {
             (Const,
                 auto ent = get_ent_fullpath(sp, crate, e2.p, EntNS::Value);
                 ASSERT_BUG(sp, ent.is_Constant(), "MIR Constant::Const("<<e2.p<<") didn't point to a Constant - " << ent.tag_str());
-                return clone_literal( ent.as_Constant()->m_value_res );
+                return ent.as_Constant()->m_value_res.clone();
                 ),
             (ItemAddr,
                 return ::HIR::Literal::make_BorrowPath( e2.clone() );
@@ -1136,16 +1109,17 @@ namespace {
                     val = const_to_lit(e);
                     ),
                 (SizedArray,
-                    ::std::vector< ::HIR::Literal>  vals;
-                    if( e.count > 0 )
+                    if( e.count > 1 )
                     {
-                        vals.reserve( e.count );
-                        val = read_param(e.val);
-                        for(unsigned int i = 1; i < e.count; i++)
-                            vals.push_back( clone_literal(val) );
-                        vals.push_back( mv$(val) );
+                        val = ::HIR::Literal::make_Repeat({ box$(read_param(e.val)), e.count });
+                    }
+                    else
+                    {
+                        ::std::vector< ::HIR::Literal>  vals;
+                        if( e.count > 0 )
+                            vals.push_back( read_param(e.val) );
+                        val = ::HIR::Literal::make_List( mv$(vals) );
                     }
-                    val = ::HIR::Literal::make_List( mv$(vals) );
                     ),
                 (Borrow,
                     if( e.type != ::HIR::BorrowType::Shared ) {
@@ -1353,6 +1327,10 @@ namespace {
                     for(const auto& v : e.vals)
                         vals.push_back( read_param(v) );
                     val = ::HIR::Literal::make_List( mv$(vals) );
+                    ::HIR::TypeRef  tmp;
+                    const auto& ty = state.get_lvalue_type(tmp, sa.dst);
+                    if( ty.m_data.is_Array() && *ty.m_data.as_Array().inner == ::HIR::CoreType::U8 )
+                        val.pack_bytes();
                     ),
                 (Variant,
                     TODO(sp, "MIR _Variant");
@@ -52,41 +52,6 @@ namespace {
 
     ::HIR::Literal evaluate_constant(const Span& sp, const ::StaticTraitResolve& resolve, NewvalState newval_state, FmtLambda name, const ::HIR::ExprPtr& expr, MonomorphState ms, ::std::vector< ::HIR::Literal> args);
 
-    ::HIR::Literal clone_literal(const ::HIR::Literal& v)
-    {
-        TU_MATCH(::HIR::Literal, (v), (e),
-        (Invalid,
-            return ::HIR::Literal();
-            ),
-        (List,
-            ::std::vector< ::HIR::Literal>  vals;
-            for(const auto& val : e) {
-                vals.push_back( clone_literal(val) );
-            }
-            return ::HIR::Literal( mv$(vals) );
-            ),
-        (Variant,
-            return ::HIR::Literal::make_Variant({ e.idx, box$(clone_literal(*e.val)) });
-            ),
-        (Integer,
-            return ::HIR::Literal(e);
-            ),
-        (Float,
-            return ::HIR::Literal(e);
-            ),
-        (BorrowPath,
-            return ::HIR::Literal(e.clone());
-            ),
-        (BorrowData,
-            return ::HIR::Literal(box$(clone_literal(*e)));
-            ),
-        (String,
-            return ::HIR::Literal(e);
-            )
-        )
-        throw "";
-    }
-
     void monomorph_literal_inplace(const Span& sp, ::HIR::Literal& lit, const MonomorphState& ms)
     {
         TU_MATCH(::HIR::Literal, (lit), (e),
@@ -113,6 +78,11 @@ namespace {
             monomorph_literal_inplace(sp, *e, ms);
             ),
         (String,
+            ),
+        (Repeat,
+            monomorph_literal_inplace(sp, *e.val, ms);
+            ),
+        (Bytes,
             )
         )
     }
@@ -329,6 +299,7 @@ namespace {
                     ),
                 (Field,
                     auto& val = get_lval(*e.val);
+                    val.expand_list();
                     MIR_ASSERT(state, val.is_List(), "LValue::Field on non-list literal - " << val.tag_str() << " - " << lv);
                     auto& vals = val.as_List();
                     MIR_ASSERT(state, e.field_index < vals.size(), "LValue::Field index out of range");
@@ -349,6 +320,7 @@ namespace {
                     ),
                 (Index,
                     auto& val = get_lval(*e.val);
+                    val.expand_list();
                     MIR_ASSERT(state, val.is_List(), "LValue::Index on non-list literal - " << val.tag_str() << " - " << lv);
                     auto& idx = get_lval(*e.idx);
                     MIR_ASSERT(state, idx.is_Integer(), "LValue::Index with non-integer index literal - " << idx.tag_str() << " - " << lv);
@@ -421,7 +393,7 @@ namespace {
                     return evaluate_constant(sp, resolve, newval_state, FMT_CB(ss, ss << e2.p;), ent.as_Constant()->m_value, {}, {});
                 }
                 else {
-                    auto val = clone_literal( ent.as_Constant()->m_value_res );
+                    auto val = ent.as_Constant()->m_value_res.clone();
                     ASSERT_BUG(sp, !val.is_Invalid(), "MIR Constant::Const("<<e2.p<<") pointed to invalid Constant - (no mir, no literal)");
                     // Monomorphise the value according to `const_ms`
                     monomorph_literal_inplace(sp, val, const_ms);
@@ -471,16 +443,17 @@ namespace {
                     val = const_to_lit(e);
                     ),
                 (SizedArray,
-                    ::std::vector< ::HIR::Literal>  vals;
-                    if( e.count > 0 )
+                    if( e.count > 1 )
                     {
-                        vals.reserve( e.count );
-                        val = read_param(e.val);
-                        for(unsigned int i = 1; i < e.count; i++)
-                            vals.push_back( clone_literal(val) );
-                        vals.push_back( mv$(val) );
+                        val = ::HIR::Literal::make_Repeat({ box$(read_param(e.val)), e.count });
+                    }
+                    else
+                    {
+                        ::std::vector< ::HIR::Literal>  vals;
+                        if( e.count > 0 )
+                            vals.push_back( read_param(e.val) );
+                        val = ::HIR::Literal::make_List( mv$(vals) );
                     }
-                    val = ::HIR::Literal::make_List( mv$(vals) );
                     ),
                 (Borrow,
                     if( e.type != ::HIR::BorrowType::Shared ) {
@@ -714,6 +687,10 @@ namespace {
                     for(const auto& v : e.vals)
                         vals.push_back( read_param(v) );
                     val = ::HIR::Literal::make_List( mv$(vals) );
+                    ::HIR::TypeRef  tmp;
+                    const auto& ty = state.get_lvalue_type(tmp, sa.dst);
+                    if( ty.m_data.is_Array() && *ty.m_data.as_Array().inner == ::HIR::CoreType::U8 )
+                        val.pack_bytes();
                     ),
                 (Variant,
                     auto ival = read_param(e.val);
@@ -806,7 +783,19 @@ namespace {
             // List
             ),
         (Array,
-            // List
+            // List (or a compact Repeat/Bytes)
+            if( auto* le = lit.opt_List() )
+            {
+                for(auto& v : *le)
+                    check_lit_type(sp, *te.inner, v);
+                // Byte arrays returned directly (i.e. not via a typed local) are packed here
+                if( *te.inner == ::HIR::CoreType::U8 )
+                    lit.pack_bytes();
+            }
+            else if( auto* le = lit.opt_Repeat() )
+            {
+                check_lit_type(sp, *te.inner, *le->val);
+            }
             ),
         (Tuple,
             // List
@@ -919,6 +908,8 @@ namespace {
             {
                 auto nvs = NewvalState { m_new_values, *m_mod_path, FMT(p.get_name() << "$") };
                 item.m_value_res = evaluate_constant(item.m_value->span(), m_resolve, mv$(nvs), FMT_CB(ss, ss << p;), item.m_value, {}, {});
+
+                check_lit_type(item.m_value->span(), item.m_type, item.m_value_res);
                 DEBUG("static: " << item.m_type <<  " = " << item.m_value_res);
                 visit_expr(item.m_value);
             }
@@ -8,340 +8,466 @@
 #include "common.hpp"
 #include <hir/path.hpp>
 
-bool visit_ty_with__path_params(const ::HIR::PathParams& tpl, t_cb_visit_ty callback)
-{
-    for(const auto& ty : tpl.m_types)
-        if( visit_ty_with(ty, callback) )
-            return true;
-    return false;
-}
-
-bool visit_ty_with__trait_path(const ::HIR::TraitPath& tpl, t_cb_visit_ty callback)
-{
-    if( visit_ty_with__path_params(tpl.m_path.m_params, callback) )
-        return true;
-    for(const auto& assoc : tpl.m_type_bounds)
-        if( visit_ty_with(assoc.second, callback) )
-            return true;
-    return false;
-}
-bool visit_ty_with__path(const ::HIR::Path& tpl, t_cb_visit_ty callback)
-{
-    TU_MATCH(::HIR::Path::Data, (tpl.m_data), (e),
-    (Generic,
-        return visit_ty_with__path_params(e.m_params, callback);
-        ),
-    (UfcsInherent,
-        return visit_ty_with(*e.type, callback) || visit_ty_with__path_params(e.params, callback);
-        ),
-    (UfcsKnown,
-        return visit_ty_with(*e.type, callback) || visit_ty_with__path_params(e.trait.m_params, callback) || visit_ty_with__path_params(e.params, callback);
-        ),
-    (UfcsUnknown,
-        return visit_ty_with(*e.type, callback) || visit_ty_with__path_params(e.params, callback);
-        )
-    )
-    throw "";
-}
-bool visit_ty_with(const ::HIR::TypeRef& ty, t_cb_visit_ty callback)
-{
-    if( callback(ty) ) {
-        return true;
-    }
+namespace {
+    /// Type visitor, statically dispatched on the callback (`bool(const ::HIR::TypeRef&)`, returning `true` stops the visit)
+    template<typename F>
+    struct TyVisitor
+    {
+        const F&    cb;
 
-    TU_MATCH(::HIR::TypeRef::Data, (ty.m_data), (e),
-    (Infer,
-        ),
-    (Diverge,
-        ),
-    (Primitive,
-        ),
-    (Generic,
-        ),
-    (Path,
-        return visit_ty_with__path(e.path, callback);
-        ),
-    (TraitObject,
-        if( visit_ty_with__trait_path(e.m_trait, callback) )
-            return true;
-        for(const auto& trait : e.m_markers)
-            if( visit_ty_with__path_params(trait.m_params, callback) )
-                return true;
-        return false;
-        ),
-    (ErasedType,
-        if( visit_ty_with__path(e.m_origin, callback) )
-            return true;
-        for(const auto& trait : e.m_traits)
-            if( visit_ty_with__trait_path(trait, callback) )
-                return true;
-        return false;
-        ),
-    (Array,
-        return visit_ty_with(*e.inner, callback);
-        ),
-    (Slice,
-        return visit_ty_with(*e.inner, callback);
-        ),
-    (Tuple,
-        for(const auto& ty : e) {
-            if( visit_ty_with(ty, callback) )
-                return true;
+        bool visit_path_params(const ::HIR::PathParams& tpl) const
+        {
+            for(const auto& ty : tpl.m_types)
+                if( visit_type(ty) )
+                    return true;
+            return false;
         }
-        return false;
-        ),
-    (Borrow,
-        return visit_ty_with(*e.inner, callback);
-        ),
-    (Pointer,
-        return visit_ty_with(*e.inner, callback);
-        ),
-    (Function,
-        for(const auto& ty : e.m_arg_types) {
-            if( visit_ty_with(ty, callback) )
+        bool visit_trait_path(const ::HIR::TraitPath& tpl) const
+        {
+            if( visit_path_params(tpl.m_path.m_params) )
                 return true;
+            for(const auto& assoc : tpl.m_type_bounds)
+                if( visit_type(assoc.second) )
+                    return true;
+            return false;
+        }
+        bool visit_path(const ::HIR::Path& tpl) const
+        {
+            TU_MATCH(::HIR::Path::Data, (tpl.m_data), (e),
+            (Generic,
+                return visit_path_params(e.m_params);
+                ),
+            (UfcsInherent,
+                return visit_type(*e.type) || visit_path_params(e.params) || visit_path_params(e.impl_params);
+                ),
+            (UfcsKnown,
+                return visit_type(*e.type) || visit_path_params(e.trait.m_params) || visit_path_params(e.params);
+                ),
+            (UfcsUnknown,
+                return visit_type(*e.type) || visit_path_params(e.params);
+                )
+            )
+            throw "";
         }
-        return visit_ty_with(*e.m_rettype, callback);
-        ),
-    (Closure,
-        for(const auto& ty : e.m_arg_types) {
-            if( visit_ty_with(ty, callback) )
+        bool visit_type(const ::HIR::TypeRef& ty) const
+        {
+            if( cb(ty) ) {
                 return true;
+            }
+
+            TU_MATCH(::HIR::TypeRef::Data, (ty.m_data), (e),
+            (Infer,
+                ),
+            (Diverge,
+                ),
+            (Primitive,
+                ),
+            (Generic,
+                ),
+            (Path,
+                return visit_path(e.path);
+                ),
+            (TraitObject,
+                if( visit_trait_path(e.m_trait) )
+                    return true;
+                for(const auto& trait : e.m_markers)
+                    if( visit_path_params(trait.m_params) )
+                        return true;
+                return false;
+                ),
+            (ErasedType,
+                if( visit_path(e.m_origin) )
+                    return true;
+                for(const auto& trait : e.m_traits)
+                    if( visit_trait_path(trait) )
+                        return true;
+                return false;
+                ),
+            (Array,
+                return visit_type(*e.inner);
+                ),
+            (Slice,
+                return visit_type(*e.inner);
+                ),
+            (Tuple,
+                for(const auto& ty : e) {
+                    if( visit_type(ty) )
+                        return true;
+                }
+                return false;
+                ),
+            (Borrow,
+                return visit_type(*e.inner);
+                ),
+            (Pointer,
+                return visit_type(*e.inner);
+                ),
+            (Function,
+                for(const auto& ty : e.m_arg_types) {
+                    if( visit_type(ty) )
+                        return true;
+                }
+                return visit_type(*e.m_rettype);
+                ),
+            (Closure,
+                for(const auto& ty : e.m_arg_types) {
+                    if( visit_type(ty) )
+                        return true;
+                }
+                return visit_type(*e.m_rettype);
+                )
+            )
+            return false;
         }
-        return visit_ty_with(*e.m_rettype, callback);
-        )
-    )
-    return false;
+    };
+    template<typename F>
+    TyVisitor<F> make_ty_visitor(const F& cb) {
+        return TyVisitor<F> { cb };
+    }
+
+    bool is_generic(const ::HIR::TypeRef& ty) {
+        return ty.m_data.is_Generic();
+    }
+}
+
+bool visit_ty_with(const ::HIR::TypeRef& ty, t_cb_visit_ty callback)
+{
+    return make_ty_visitor(callback).visit_type(ty);
 }
 
 bool monomorphise_pathparams_needed(const ::HIR::PathParams& tpl)
 {
-    return visit_ty_with__path_params(tpl, [&](const auto& ty) {
-        return (ty.m_data.is_Generic() ? true : false);
-        });
+    return make_ty_visitor(is_generic).visit_path_params(tpl);
 }
 bool monomorphise_traitpath_needed(const ::HIR::TraitPath& tpl)
 {
-    return visit_ty_with__trait_path(tpl, [&](const auto& ty) {
-        return (ty.m_data.is_Generic() ? true : false);
-        });
+    return make_ty_visitor(is_generic).visit_trait_path(tpl);
 }
 bool monomorphise_path_needed(const ::HIR::Path& tpl)
 {
-    return visit_ty_with__path(tpl, [&](const auto& ty) {
-        return (ty.m_data.is_Generic() ? true : false);
-        });
+    return make_ty_visitor(is_generic).visit_path(tpl);
 }
 bool monomorphise_type_needed(const ::HIR::TypeRef& tpl)
 {
-    return visit_ty_with(tpl, [&](const auto& ty) {
-        return (ty.m_data.is_Generic() ? true : false);
-        });
+    return make_ty_visitor(is_generic).visit_type(tpl);
 }
 
 
-::HIR::PathParams clone_ty_with__path_params(const Span& sp, const ::HIR::PathParams& tpl, t_cb_clone_ty callback) {
-    ::HIR::PathParams   rv;
-    rv.m_types.reserve( tpl.m_types.size() );
-    for( const auto& ty : tpl.m_types)
-        rv.m_types.push_back( clone_ty_with(sp, ty, callback) );
-    return rv;
-}
-::HIR::GenericPath clone_ty_with__generic_path(const Span& sp, const ::HIR::GenericPath& tpl, t_cb_clone_ty callback) {
-    return ::HIR::GenericPath( tpl.m_path, clone_ty_with__path_params(sp, tpl.m_params, callback) );
-}
-::HIR::TraitPath clone_ty_with__trait_path(const Span& sp, const ::HIR::TraitPath& tpl, t_cb_clone_ty callback) {
-    ::HIR::TraitPath    rv {
-        clone_ty_with__generic_path(sp, tpl.m_path, callback),
-        tpl.m_hrls,
-        {},
-        tpl.m_trait_ptr
-        };
-
-    for(const auto& assoc : tpl.m_type_bounds) {
-        rv.m_type_bounds.insert(::std::make_pair(
-            assoc.first,
-            clone_ty_with(sp, assoc.second, callback)
-            ));
-    }
-
-    return rv;
-}
-::HIR::Path clone_ty_with__path(const Span& sp, const ::HIR::Path& tpl, t_cb_clone_ty callback) {
-    TU_MATCH(::HIR::Path::Data, (tpl.m_data), (e2),
-    (Generic,
-        return ::HIR::Path( clone_ty_with__generic_path(sp, e2, callback) );
-        ),
-    (UfcsKnown,
-        return ::HIR::Path::Data::make_UfcsKnown({
-            box$( clone_ty_with(sp, *e2.type, callback) ),
-            clone_ty_with__generic_path(sp, e2.trait, callback),
-            e2.item,
-            clone_ty_with__path_params(sp, e2.params, callback)
-            });
-        ),
-    (UfcsUnknown,
-        return ::HIR::Path::Data::make_UfcsUnknown({
-            box$( clone_ty_with(sp, *e2.type, callback) ),
-            e2.item,
-            clone_ty_with__path_params(sp, e2.params, callback)
-            });
-        ),
-    (UfcsInherent,
-        return ::HIR::Path::Data::make_UfcsInherent({
-            box$( clone_ty_with(sp, *e2.type, callback) ),
-            e2.item,
-            clone_ty_with__path_params(sp, e2.params, callback),
-            clone_ty_with__path_params(sp, e2.impl_params, callback)
-            });
-        )
-    )
-    throw "";
-}
-::HIR::TypeRef clone_ty_with(const Span& sp, const ::HIR::TypeRef& tpl, t_cb_clone_ty callback)
-{
-    ::HIR::TypeRef  rv;
-
-    if( callback(tpl, rv) ) {
-        DEBUG(tpl << " => " << rv);
-        return rv;
-    }
+namespace {
+    /// Type cloner, statically dispatched on the callback (`bool(const ::HIR::TypeRef&, ::HIR::TypeRef&)`, returning `true` if it set a replacement)
+    template<typename F>
+    struct TyCloner
+    {
+        const Span& sp;
+        const F&    cb;
 
-    TU_MATCH(::HIR::TypeRef::Data, (tpl.m_data), (e),
-    (Infer,
-        rv = ::HIR::TypeRef(e);
-        ),
-    (Diverge,
-        rv = ::HIR::TypeRef(e);
-        ),
-    (Primitive,
-        rv = ::HIR::TypeRef(e);
-        ),
-    (Path,
-        rv = ::HIR::TypeRef( ::HIR::TypeRef::Data::Data_Path {
-            clone_ty_with__path(sp, e.path, callback),
-            e.binding.clone()
-            } );
-        // If the input binding was Opaque, clear it back to Unbound
-        if( e.binding.is_Opaque() ) {
-            rv.m_data.as_Path().binding = ::HIR::TypeRef::TypePathBinding();
+        ::HIR::PathParams clone_path_params(const ::HIR::PathParams& tpl) const {
+            ::HIR::PathParams   rv;
+            rv.m_types.reserve( tpl.m_types.size() );
+            for( const auto& ty : tpl.m_types)
+                rv.m_types.push_back( clone_type(ty) );
+            return rv;
         }
-        ),
-    (Generic,
-        rv = ::HIR::TypeRef(e);
-        ),
-    (TraitObject,
-        ::HIR::TypeRef::Data::Data_TraitObject  to;
-        to.m_trait = clone_ty_with__trait_path(sp, e.m_trait, callback);
-        for(const auto& trait : e.m_markers)
-        {
-            to.m_markers.push_back( clone_ty_with__generic_path(sp, trait, callback) );
+        ::HIR::GenericPath clone_generic_path(const ::HIR::GenericPath& tpl) const {
+            return ::HIR::GenericPath( tpl.m_path, clone_path_params(tpl.m_params) );
         }
-        to.m_lifetime = e.m_lifetime;
-        rv = ::HIR::TypeRef( mv$(to) );
-        ),
-    (ErasedType,
-        auto origin = clone_ty_with__path(sp, e.m_origin, callback);
+        ::HIR::TraitPath clone_trait_path(const ::HIR::TraitPath& tpl) const {
+            ::HIR::TraitPath    rv {
+                clone_generic_path(tpl.m_path),
+                tpl.m_hrls,
+                {},
+                tpl.m_trait_ptr
+                };
 
-        ::std::vector< ::HIR::TraitPath>    traits;
-        traits.reserve( e.m_traits.size() );
-        for(const auto& trait : e.m_traits)
-            traits.push_back( clone_ty_with__trait_path(sp, trait, callback) );
+            for(const auto& assoc : tpl.m_type_bounds) {
+                rv.m_type_bounds.insert(::std::make_pair(
+                    assoc.first,
+                    clone_type(assoc.second)
+                    ));
+            }
 
-        rv = ::HIR::TypeRef( ::HIR::TypeRef::Data::Data_ErasedType {
-            mv$(origin), e.m_index,
-            mv$(traits),
-            e.m_lifetime
-            } );
-        ),
-    (Array,
-        if( e.size_val == ~0u ) {
-            rv = ::HIR::TypeRef( ::HIR::TypeRef::Data::make_Array({ box$(clone_ty_with(sp, *e.inner, callback)), e.size, ~0u }) );
+            return rv;
         }
-        else {
-            rv = ::HIR::TypeRef::new_array( clone_ty_with(sp, *e.inner, callback), e.size_val );
+        ::HIR::Path clone_path(const ::HIR::Path& tpl) const {
+            TU_MATCH(::HIR::Path::Data, (tpl.m_data), (e2),
+            (Generic,
+                return ::HIR::Path( clone_generic_path(e2) );
+                ),
+            (UfcsKnown,
+                return ::HIR::Path::Data::make_UfcsKnown({
+                    box$( clone_type(*e2.type) ),
+                    clone_generic_path(e2.trait),
+                    e2.item,
+                    clone_path_params(e2.params)
+                    });
+                ),
+            (UfcsUnknown,
+                return ::HIR::Path::Data::make_UfcsUnknown({
+                    box$( clone_type(*e2.type) ),
+                    e2.item,
+                    clone_path_params(e2.params)
+                    });
+                ),
+            (UfcsInherent,
+                return ::HIR::Path::Data::make_UfcsInherent({
+                    box$( clone_type(*e2.type) ),
+                    e2.item,
+                    clone_path_params(e2.params),
+                    clone_path_params(e2.impl_params)
+                    });
+                )
+            )
+            throw "";
         }
-        ),
-    (Slice,
-        rv = ::HIR::TypeRef::new_slice( clone_ty_with(sp, *e.inner, callback) );
-        ),
-    (Tuple,
-        ::std::vector< ::HIR::TypeRef>  types;
-        for(const auto& ty : e) {
-            types.push_back( clone_ty_with(sp, ty, callback) );
+        ::HIR::TypeRef clone_type(const ::HIR::TypeRef& tpl) const
+        {
+            ::HIR::TypeRef  rv;
+
+            if( cb(tpl, rv) ) {
+                DEBUG(tpl << " => " << rv);
+                return rv;
+            }
+
+            TU_MATCH(::HIR::TypeRef::Data, (tpl.m_data), (e),
+            (Infer,
+                rv = ::HIR::TypeRef(e);
+                ),
+            (Diverge,
+                rv = ::HIR::TypeRef(e);
+                ),
+            (Primitive,
+                rv = ::HIR::TypeRef(e);
+                ),
+            (Path,
+                rv = ::HIR::TypeRef( ::HIR::TypeRef::Data::Data_Path {
+                    clone_path(e.path),
+                    e.binding.clone()
+                    } );
+                // If the input binding was Opaque, clear it back to Unbound
+                if( e.binding.is_Opaque() ) {
+                    rv.m_data.as_Path().binding = ::HIR::TypeRef::TypePathBinding();
+                }
+                ),
+            (Generic,
+                rv = ::HIR::TypeRef(e);
+                ),
+            (TraitObject,
+                ::HIR::TypeRef::Data::Data_TraitObject  to;
+                to.m_trait = clone_trait_path(e.m_trait);
+                for(const auto& trait : e.m_markers)
+                {
+                    to.m_markers.push_back( clone_generic_path(trait) );
+                }
+                to.m_lifetime = e.m_lifetime;
+                rv = ::HIR::TypeRef( mv$(to) );
+                ),
+            (ErasedType,
+                auto origin = clone_path(e.m_origin);
+
+                ::std::vector< ::HIR::TraitPath>    traits;
+                traits.reserve( e.m_traits.size() );
+                for(const auto& trait : e.m_traits)
+                    traits.push_back( clone_trait_path(trait) );
+
+                rv = ::HIR::TypeRef( ::HIR::TypeRef::Data::Data_ErasedType {
+                    mv$(origin), e.m_index,
+                    mv$(traits),
+                    e.m_lifetime
+                    } );
+                ),
+            (Array,
+                if( e.size_val == ~0u ) {
+                    rv = ::HIR::TypeRef( ::HIR::TypeRef::Data::make_Array({ box$(clone_type(*e.inner)), e.size, ~0u }) );
+                }
+                else {
+                    rv = ::HIR::TypeRef::new_array( clone_type(*e.inner), e.size_val );
+                }
+                ),
+            (Slice,
+                rv = ::HIR::TypeRef::new_slice( clone_type(*e.inner) );
+                ),
+            (Tuple,
+                ::std::vector< ::HIR::TypeRef>  types;
+                types.reserve( e.size() );
+                for(const auto& ty : e) {
+                    types.push_back( clone_type(ty) );
+                }
+                rv = ::HIR::TypeRef( mv$(types) );
+                ),
+            (Borrow,
+                rv = ::HIR::TypeRef::new_borrow (e.type, clone_type(*e.inner));
+                ),
+            (Pointer,
+                rv = ::HIR::TypeRef::new_pointer(e.type, clone_type(*e.inner));
+                ),
+            (Function,
+                ::HIR::FunctionType ft;
+                ft.is_unsafe = e.is_unsafe;
+                ft.m_abi = e.m_abi;
+                ft.m_rettype = box$( clone_type(*e.m_rettype) );
+                ft.m_arg_types.reserve( e.m_arg_types.size() );
+                for( const auto& arg : e.m_arg_types )
+                    ft.m_arg_types.push_back( clone_type(arg) );
+                rv = ::HIR::TypeRef( mv$(ft) );
+                ),
+            (Closure,
+                ::HIR::TypeRef::Data::Data_Closure  oe;
+                oe.node = e.node;
+                oe.m_rettype = box$( clone_type(*e.m_rettype) );
+                oe.m_arg_types.reserve( e.m_arg_types.size() );
+                for(const auto& a : e.m_arg_types)
+                    oe.m_arg_types.push_back( clone_type(a) );
+                rv = ::HIR::TypeRef( mv$(oe) );
+                )
+            )
+            return rv;
         }
-        rv = ::HIR::TypeRef( mv$(types) );
-        ),
-    (Borrow,
-        rv = ::HIR::TypeRef::new_borrow (e.type, clone_ty_with(sp, *e.inner, callback));
-        ),
-    (Pointer,
-        rv = ::HIR::TypeRef::new_pointer(e.type, clone_ty_with(sp, *e.inner, callback));
-        ),
-    (Function,
-        ::HIR::FunctionType ft;
-        ft.is_unsafe = e.is_unsafe;
-        ft.m_abi = e.m_abi;
-        ft.m_rettype = box$( clone_ty_with(sp, *e.m_rettype, callback) );
-        for( const auto& arg : e.m_arg_types )
-            ft.m_arg_types.push_back( clone_ty_with(sp, arg, callback) );
-        rv = ::HIR::TypeRef( mv$(ft) );
-        ),
-    (Closure,
-        ::HIR::TypeRef::Data::Data_Closure  oe;
-        oe.node = e.node;
-        oe.m_rettype = box$( clone_ty_with(sp, *e.m_rettype, callback) );
-        for(const auto& a : e.m_arg_types)
-            oe.m_arg_types.push_back( clone_ty_with(sp, a, callback) );
-        rv = ::HIR::TypeRef( mv$(oe) );
-        )
-    )
-    return rv;
+    };
+    template<typename F>
+    TyCloner<F> make_ty_cloner(const Span& sp, const F& cb) {
+        return TyCloner<F> { sp, cb };
+    }
+}
+
+::HIR::TypeRef clone_ty_with(const Span& sp, const ::HIR::TypeRef& tpl, t_cb_clone_ty callback)
+{
+    return make_ty_cloner(sp, callback).clone_type(tpl);
 }
 
 namespace {
-    template<typename T>
-    t_cb_clone_ty monomorphise_type_with__closure(const Span& sp, const T& outer_tpl, t_cb_generic& callback, bool allow_infer)
+    /// `TyCloner` callback that replaces generics using `getter` (a `const ::HIR::TypeRef&(const ::HIR::TypeRef&)` callable)
+    template<typename G, typename T>
+    struct MonomorphCb
     {
-        return [&sp,&outer_tpl,callback,allow_infer](const auto& tpl, auto& rv) {
+        const Span& sp;
+        const T&    outer_tpl;
+        const G&    getter;
+        bool    allow_infer;
+
+        bool operator()(const ::HIR::TypeRef& tpl, ::HIR::TypeRef& rv) const {
             if( tpl.m_data.is_Infer() && !allow_infer )
                BUG(sp, "_ type found in " << outer_tpl);
 
             if( tpl.m_data.is_Generic() ) {
-                rv = callback(tpl).clone();
+                rv = getter(tpl).clone();
                 return true;
             }
 
             return false;
-            };
+        }
+    };
+
+    /// Monomorphise any of the type-containing HIR items, statically dispatched on the generic source
+    /// - If nothing within `tpl` needs replacing (the common case once in trans), it's cloned directly instead of walked
+    template<typename G>
+    struct Monomorphiser
+    {
+        const Span& sp;
+        const G&    getter;
+        bool    allow_infer;
+
+        bool walk_needed(const ::HIR::TypeRef& ty) const {
+            if( ty.m_data.is_Generic() )
+                return true;
+            if( ty.m_data.is_Infer() )
+                return !allow_infer;
+            // Opaque bindings are reset by the clone
+            if( const auto* e = ty.m_data.opt_Path() )
+                return e->binding.is_Opaque();
+            return false;
+        }
+        template<typename T>
+        MonomorphCb<G,T> get_cb(const T& tpl) const {
+            return MonomorphCb<G,T> { sp, tpl, getter, allow_infer };
+        }
+
+        ::HIR::PathParams path_params(const ::HIR::PathParams& tpl) const {
+            auto needed = [&](const auto& ty){ return this->walk_needed(ty); };
+            if( !make_ty_visitor(needed).visit_path_params(tpl) )
+                return tpl.clone();
+            auto cb = get_cb(tpl);
+            return make_ty_cloner(sp, cb).clone_path_params(tpl);
+        }
+        ::HIR::GenericPath generic_path(const ::HIR::GenericPath& tpl) const {
+            auto needed = [&](const auto& ty){ return this->walk_needed(ty); };
+            if( !make_ty_visitor(needed).visit_path_params(tpl.m_params) )
+                return tpl.clone();
+            auto cb = get_cb(tpl);
+            return make_ty_cloner(sp, cb).clone_generic_path(tpl);
+        }
+        ::HIR::TraitPath trait_path(const ::HIR::TraitPath& tpl) const {
+            auto needed = [&](const auto& ty){ return this->walk_needed(ty); };
+            if( !make_ty_visitor(needed).visit_trait_path(tpl) )
+                return tpl.clone();
+            auto cb = get_cb(tpl);
+            return make_ty_cloner(sp, cb).clone_trait_path(tpl);
+        }
+        ::HIR::Path path(const ::HIR::Path& tpl) const {
+            auto needed = [&](const auto& ty){ return this->walk_needed(ty); };
+            if( !make_ty_visitor(needed).visit_path(tpl) )
+                return tpl.clone();
+            auto cb = get_cb(tpl);
+            return make_ty_cloner(sp, cb).clone_path(tpl);
+        }
+        ::HIR::TypeRef type(const ::HIR::TypeRef& tpl) const {
+            auto needed = [&](const auto& ty){ return this->walk_needed(ty); };
+            if( !make_ty_visitor(needed).visit_type(tpl) )
+                return tpl.clone();
+            auto cb = get_cb(tpl);
+            return make_ty_cloner(sp, cb).clone_type(tpl);
+        }
+    };
+    template<typename G>
+    Monomorphiser<G> make_monomorphiser(const Span& sp, const G& getter, bool allow_infer) {
+        return Monomorphiser<G> { sp, getter, allow_infer };
     }
 }
 
 ::HIR::PathParams monomorphise_path_params_with(const Span& sp, const ::HIR::PathParams& tpl, t_cb_generic callback, bool allow_infer)
 {
-    return clone_ty_with__path_params(sp, tpl, monomorphise_type_with__closure(sp, tpl, callback, allow_infer));
+    return make_monomorphiser(sp, callback, allow_infer).path_params(tpl);
 }
 ::HIR::GenericPath monomorphise_genericpath_with(const Span& sp, const ::HIR::GenericPath& tpl, t_cb_generic callback, bool allow_infer)
 {
-    return clone_ty_with__generic_path(sp, tpl, monomorphise_type_with__closure(sp, tpl, callback, allow_infer));
+    return make_monomorphiser(sp, callback, allow_infer).generic_path(tpl);
 }
 ::HIR::TraitPath monomorphise_traitpath_with(const Span& sp, const ::HIR::TraitPath& tpl, t_cb_generic callback, bool allow_infer)
 {
-    return clone_ty_with__trait_path(sp, tpl, monomorphise_type_with__closure(sp, tpl, callback, allow_infer));
+    return make_monomorphiser(sp, callback, allow_infer).trait_path(tpl);
 }
 ::HIR::Path monomorphise_path_with(const Span& sp, const ::HIR::Path& tpl, t_cb_generic callback, bool allow_infer)
 {
-    return clone_ty_with__path(sp, tpl, monomorphise_type_with__closure(sp, tpl, callback, allow_infer));
+    return make_monomorphiser(sp, callback, allow_infer).path(tpl);
 }
-::HIR::TypeRef monomorphise_type_with_inner(const Span& sp, const ::HIR::TypeRef& outer_tpl, t_cb_generic callback, bool allow_infer)
+::HIR::TypeRef monomorphise_type_with(const Span& sp, const ::HIR::TypeRef& tpl, t_cb_generic callback, bool allow_infer)
 {
-    return clone_ty_with(sp, outer_tpl, monomorphise_type_with__closure(sp, outer_tpl, callback, allow_infer));
+    ::HIR::TypeRef  rv;
+    TRACE_FUNCTION_FR("tpl = " << tpl, rv);
+    rv = make_monomorphiser(sp, callback, allow_infer).type(tpl);
+    return rv;
 }
-::HIR::TypeRef monomorphise_type_with(const Span& sp, const ::HIR::TypeRef& tpl, t_cb_generic callback, bool allow_infer)
+
+::HIR::PathParams monomorphise_path_params_with(const Span& sp, const ::HIR::PathParams& tpl, const MonomorphiserPP& ms, bool allow_infer)
+{
+    return make_monomorphiser(sp, ms, allow_infer).path_params(tpl);
+}
+::HIR::GenericPath monomorphise_genericpath_with(const Span& sp, const ::HIR::GenericPath& tpl, const MonomorphiserPP& ms, bool allow_infer)
+{
+    return make_monomorphiser(sp, ms, allow_infer).generic_path(tpl);
+}
+::HIR::TraitPath monomorphise_traitpath_with(const Span& sp, const ::HIR::TraitPath& tpl, const MonomorphiserPP& ms, bool allow_infer)
+{
+    return make_monomorphiser(sp, ms, allow_infer).trait_path(tpl);
+}
+::HIR::Path monomorphise_path_with(const Span& sp, const ::HIR::Path& tpl, const MonomorphiserPP& ms, bool allow_infer)
+{
+    return make_monomorphiser(sp, ms, allow_infer).path(tpl);
+}
+::HIR::TypeRef monomorphise_type_with(const Span& sp, const ::HIR::TypeRef& tpl, const MonomorphiserPP& ms, bool allow_infer)
 {
     ::HIR::TypeRef  rv;
     TRACE_FUNCTION_FR("tpl = " << tpl, rv);
-    rv = monomorphise_type_with_inner(sp, tpl, callback, allow_infer);
+    rv = make_monomorphiser(sp, ms, allow_infer).type(tpl);
     return rv;
 }
 
@@ -352,7 +478,7 @@ namespace {
     DEBUG("tpl = " << tpl);
     ASSERT_BUG(sp, params.m_types.size() == params_def.m_types.size(),
         "Parameter count mismatch - exp " << params_def.m_types.size() << ", got " << params.m_types.size() << " for " << params << " and " << params_def.fmt_args());
-    return monomorphise_type_with(sp, tpl, [&](const auto& gt)->const auto& {
+    auto getter = [&](const ::HIR::TypeRef& gt)->const ::HIR::TypeRef& {
         const auto& e = gt.m_data.as_Generic();
         if( e.binding == 0xFFFF ) {
             TODO(sp, "Handle 'Self' in `monomorphise_type`");
@@ -370,10 +496,11 @@ namespace {
         else {
             BUG(sp, "Unknown param in `monomorphise_type` - " << gt);
         }
-        }, false);
+        };
+    return make_monomorphiser(sp, getter, false).type(tpl);
 }
 
-t_cb_generic MonomorphState::get_cb(const Span& sp) const
+MonomorphiserPP MonomorphState::get_cb(const Span& sp) const
 {
     return monomorphise_type_get_cb(sp, this->self_ty, this->pp_impl, this->pp_method);
 }
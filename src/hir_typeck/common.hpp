@@ -29,6 +29,48 @@ extern ::HIR::Path monomorphise_path_with(const Span& sp, const ::HIR::Path& tpl
 extern ::HIR::TypeRef monomorphise_type_with(const Span& sp, const ::HIR::TypeRef& tpl, t_cb_generic callback, bool allow_infer=true);
 extern ::HIR::TypeRef monomorphise_type(const Span& sp, const ::HIR::GenericParams& params_def, const ::HIR::PathParams& params,  const ::HIR::TypeRef& tpl);
 
+/// Replaces generics with `Self`, impl-level, method-level or placeholder parameters
+///
+/// The `monomorphise_*_with` overloads taking this call `get_generic` directly instead of through a `t_cb_generic`,
+/// it's also callable so can be passed where a `t_cb_generic` is expected. The span must outlive this.
+struct MonomorphiserPP
+{
+    const Span* sp;
+    const ::HIR::TypeRef*   self_ty;
+    const ::HIR::PathParams*    params_i;
+    const ::HIR::PathParams*    params_m;
+    const ::HIR::PathParams*    params_p;
+
+    const ::HIR::TypeRef& get_generic(const ::HIR::TypeRef& gt) const
+    {
+        const auto& ge = gt.m_data.as_Generic();
+        if( ge.binding == 0xFFFF ) {
+            ASSERT_BUG(*sp, self_ty, "Self wasn't expected here");
+            return *self_ty;
+        }
+        const ::HIR::PathParams* params;
+        switch( ge.binding >> 8 )
+        {
+        case 0: params = params_i;  ASSERT_BUG(*sp, params, "Impl-level params were not expected - " << gt);   break;
+        case 1: params = params_m;  ASSERT_BUG(*sp, params, "Method-level params were not expected - " << gt); break;
+        case 2: params = params_p;  ASSERT_BUG(*sp, params, "Placeholder params were not expected - " << gt);  break;
+        default:
+            BUG(*sp, "Invalid generic type - " << gt);
+        }
+        auto idx = ge.binding & 0xFF;
+        ASSERT_BUG(*sp, idx < params->m_types.size(), "Parameter out of range " << gt << " >= " << params->m_types.size());
+        return params->m_types[idx];
+    }
+    const ::HIR::TypeRef& operator()(const ::HIR::TypeRef& gt) const {
+        return get_generic(gt);
+    }
+};
+extern ::HIR::PathParams monomorphise_path_params_with(const Span& sp, const ::HIR::PathParams& tpl, const MonomorphiserPP& ms, bool allow_infer);
+extern ::HIR::GenericPath monomorphise_genericpath_with(const Span& sp, const ::HIR::GenericPath& tpl, const MonomorphiserPP& ms, bool allow_infer);
+extern ::HIR::TraitPath monomorphise_traitpath_with(const Span& sp, const ::HIR::TraitPath& tpl, const MonomorphiserPP& ms, bool allow_infer);
+extern ::HIR::Path monomorphise_path_with(const Span& sp, const ::HIR::Path& tpl, const MonomorphiserPP& ms, bool allow_infer);
+extern ::HIR::TypeRef monomorphise_type_with(const Span& sp, const ::HIR::TypeRef& tpl, const MonomorphiserPP& ms, bool allow_infer=true);
+
 typedef ::std::function<bool(const ::HIR::TypeRef&)> t_cb_visit_ty;
 /// Calls the provided callback on every type seen when recursing the type.
 /// If the callback returns `true`, no further types are visited and the function returns `true`.
@@ -75,7 +117,7 @@ struct MonomorphState
         return rv;
     }
 
-    t_cb_generic    get_cb(const Span& sp) const;
+    MonomorphiserPP get_cb(const Span& sp) const;
 
     ::HIR::TypeRef  monomorph(const Span& sp, const ::HIR::TypeRef& ty, bool allow_infer=true) const {
         return monomorphise_type_with(sp, ty, this->get_cb(sp), allow_infer);
@@ -86,36 +128,9 @@ struct MonomorphState
 };
 extern ::std::ostream& operator<<(::std::ostream& os, const MonomorphState& ms);
 
-static inline t_cb_generic monomorphise_type_get_cb(const Span& sp, const ::HIR::TypeRef* self_ty, const ::HIR::PathParams* params_i, const ::HIR::PathParams* params_m, const ::HIR::PathParams* params_p=nullptr)
+static inline MonomorphiserPP monomorphise_type_get_cb(const Span& sp, const ::HIR::TypeRef* self_ty, const ::HIR::PathParams* params_i, const ::HIR::PathParams* params_m, const ::HIR::PathParams* params_p=nullptr)
 {
-    return [=](const ::HIR::TypeRef& gt)->const ::HIR::TypeRef& {
-        const auto& ge = gt.m_data.as_Generic();
-        if( ge.binding == 0xFFFF ) {
-            ASSERT_BUG(sp, self_ty, "Self wasn't expected here");
-            return *self_ty;
-        }
-        else if( (ge.binding >> 8) == 0 ) {
-            auto idx = ge.binding & 0xFF;
-            ASSERT_BUG(sp, params_i, "Impl-level params were not expected - " << gt);
-            ASSERT_BUG(sp, idx < params_i->m_types.size(), "Parameter out of range " << gt << " >= " << params_i->m_types.size());
-            return params_i->m_types[idx];
-        }
-        else if( (ge.binding >> 8) == 1 ) {
-            auto idx = ge.binding & 0xFF;
-            ASSERT_BUG(sp, params_m, "Method-level params were not expected - " << gt);
-            ASSERT_BUG(sp, idx < params_m->m_types.size(), "Parameter out of range " << gt << " >= " << params_m->m_types.size());
-            return params_m->m_types[idx];
-        }
-        else if( (ge.binding >> 8) == 2 ) {
-            auto idx = ge.binding & 0xFF;
-            ASSERT_BUG(sp, params_p, "Placeholder params were not expected - " << gt);
-            ASSERT_BUG(sp, idx < params_p->m_types.size(), "Parameter out of range " << gt << " >= " << params_p->m_types.size());
-            return params_p->m_types[idx];
-        }
-        else {
-            BUG(sp, "Invalid generic type - " << gt);
-        }
-        };
+    return MonomorphiserPP { &sp, self_ty, params_i, params_m, params_p };
 }
 
 extern void check_type_class_primitive(const Span& sp, const ::HIR::TypeRef& type, ::HIR::InferClass ic, ::HIR::CoreType ct);
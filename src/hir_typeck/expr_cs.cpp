@@ -13,6 +13,7 @@
 
 #include "helpers.hpp"
 #include "expr_visit.hpp"
+#include <profile.hpp>
 
 namespace {
     inline HIR::ExprNodeP mk_exprnodep(HIR::ExprNode* en, ::HIR::TypeRef ty){ en->m_res_type = mv$(ty); return HIR::ExprNodeP(en); }
@@ -6300,6 +6301,8 @@ void Typecheck_Code_CS(const typeck::ModuleState& ms, t_args& args, const ::HIR:
     if( count == MAX_ITERATIONS ) {
         BUG(root_ptr->span(), "Typecheck ran for too many iterations, max - " << MAX_ITERATIONS);
     }
+    // Report the iteration count against this item's profile entry (see `--profile`)
+    ProfileScope::add_count(count);
 
     if( context.has_rules() )
     {
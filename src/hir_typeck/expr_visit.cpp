@@ -4,9 +4,12 @@
 #include <hir/expr.hpp>
 #include <hir/visitor.hpp>
 #include "expr_visit.hpp"
+#include <profile.hpp>
 
 namespace {
     void Typecheck_Code(const typeck::ModuleState& ms, t_args& args, const ::HIR::TypeRef& result_type, ::HIR::ExprPtr& expr) {
+        // Nodes added while typechecking (e.g. coercions) get an arena of their own
+        ::HIR::ExprArenaScope   arena;
         //Typecheck_Code_Simple(ms, args, result_type, expr);
         Typecheck_Code_CS(ms, args, result_type, expr);
     }
@@ -97,6 +100,7 @@ namespace {
             if( item.m_code )
             {
                 DEBUG("Function code " << p);
+                PROFILE_ITEM("typeck", p);
                 Typecheck_Code( m_ms, item.m_args, item.m_return, item.m_code );
             }
             else
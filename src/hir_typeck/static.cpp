@@ -369,7 +369,7 @@ bool StaticTraitResolve::find_impl(
             return rv;
 
         // Detect recursion and return true if detected
-        static ::std::vector< ::std::tuple< const ::HIR::SimplePath*, const ::HIR::PathParams*, const ::HIR::TypeRef*> >    stack;
+        auto& stack = m_auto_trait_stack;
         for(const auto& ent : stack ) {
             if( *::std::get<0>(ent) != trait_path )
                 continue ;
@@ -382,9 +382,10 @@ bool StaticTraitResolve::find_impl(
         }
         stack.push_back( ::std::make_tuple( &trait_path, trait_params, &type ) );
         struct Guard {
-            ~Guard() { stack.pop_back(); }
+            decltype(stack)& s;
+            ~Guard() { s.pop_back(); }
         };
-        Guard   _;
+        Guard   _ { stack };
 
         auto cmp = this->check_auto_trait_impl_destructure(sp, trait_path, trait_params, type);
         if( cmp != ::HIR::Compare::Unequal )
@@ -1736,7 +1737,8 @@ bool StaticTraitResolve::type_needs_drop_glue(const Span& sp, const ::HIR::TypeR
             return true;
 
         auto pp = ::HIR::PathParams();
-        bool has_direct_drop = this->find_impl(sp, m_lang_Drop, &pp, ty, [&](auto , bool){ return true; }, true);
+        // NOTE: `#![no_core]` crates may not define the `drop` lang item (so no type can have a Drop impl)
+        bool has_direct_drop = m_lang_Drop != ::HIR::SimplePath() && this->find_impl(sp, m_lang_Drop, &pp, ty, [&](auto , bool){ return true; }, true);
         if( has_direct_drop )
             return true;
 
@@ -34,6 +34,8 @@ public:
 
 private:
     mutable ::std::map< ::HIR::TypeRef, bool >  m_copy_cache;
+    /// Auto trait impls currently being checked by `find_impl` (recursion guard, per-instance as workers each have their own resolver)
+    mutable ::std::vector< ::std::tuple< const ::HIR::SimplePath*, const ::HIR::PathParams*, const ::HIR::TypeRef*> >    m_auto_trait_stack;
 
 public:
     StaticTraitResolve(const ::HIR::Crate& crate):
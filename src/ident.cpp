@@ -9,22 +9,33 @@
 #include <ident.hpp>
 #include <debug.hpp>
 #include <common.hpp>   // vector print
+#include <algorithm>
 
-unsigned int Ident::Hygiene::g_next_scope = 0;
+// Entry zero is the root context, which is its own parent
+::std::vector<unsigned int> Ident::Hygiene::s_scope_parents { 0 };
+
+unsigned int Ident::Hygiene::alloc_scope(unsigned int parent)
+{
+    assert(parent < s_scope_parents.size());
+    s_scope_parents.push_back(parent);
+    return s_scope_parents.size() - 1;
+}
 
 bool Ident::Hygiene::is_visible(const Hygiene& src) const
 {
     // HACK: Disable hygiene for now
     //return true;
 
-    if( this->contexts.size() == 0 ) {
-        return src.contexts.size() == 0;
+    if( this->m_scope == 0 ) {
+        return src.m_scope == 0;
     }
 
-    auto des = this->contexts.back();
-    for(const auto& c : src.contexts)
-        if( des == c )
+    // Visible if this context is `src` or one of its ancestors
+    for(auto c = src.m_scope; c != 0; c = s_scope_parents[c])
+    {
+        if( c == this->m_scope )
             return true;
+    }
     return false;
 }
 
@@ -34,7 +45,12 @@ bool Ident::Hygiene::is_visible(const Hygiene& src) const
 }
 
 ::std::ostream& operator<<(::std::ostream& os, const Ident::Hygiene& x) {
-    os << "{" << x.contexts << "}";
+    // Print the chain of contexts (outermost first)
+    ::std::vector<unsigned int> chain;
+    for(auto c = x.m_scope; c != 0; c = Ident::Hygiene::s_scope_parents[c])
+        chain.push_back(c);
+    ::std::reverse(chain.begin(), chain.end());
+    os << "{" << chain << "}";
     return os;
 }
 
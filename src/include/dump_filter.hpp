@@ -0,0 +1,37 @@
+/*
+ * MRustC - Rust Compiler
+ * - By John Hodge (Mutabah/thePowersGang)
+ *
+ * include/dump_filter.hpp
+ * - Item selection and output for the IR dumps (`--emit-dump`)
+ */
+#pragma once
+
+#include <string>
+#include <ostream>
+#include <memory>
+#include <stdexcept>
+
+/// Selects which items are written by the AST/HIR/MIR dumps
+///
+/// Items are matched by their path as printed in the dumps (e.g. `"mycrate"::module::func` or
+/// `<Foo as Trait>::method`) against a glob, where `*` matches any sequence of characters and `?` any single one.
+class DumpFilter
+{
+    ::std::string   m_glob;
+public:
+    DumpFilter()
+    {}
+    DumpFilter(::std::string glob):
+        m_glob( ::std::move(glob) )
+    {}
+
+    /// True if every item is selected (the dump is then written as a nested module tree)
+    bool is_all() const {
+        return m_glob.empty() || m_glob == "*";
+    }
+    bool matches(const ::std::string& item_path) const;
+};
+
+/// Open an output file for a dump, compressing with gzip if requested
+extern ::std::unique_ptr<::std::ostream> DumpFile_Open(const ::std::string& filename, bool compress);
@@ -8,41 +8,40 @@
 #pragma once
 #include <vector>
 #include <string>
+#include <rc_string.hpp>
 
 struct Ident
 {
+    /// Syntax context - an index into a global parent-pointer tree of scopes
+    ///
+    /// Index zero is the root context (i.e. no hygiene), every other context has a single parent.
     class Hygiene
     {
-        static unsigned g_next_scope;
+        /// Parent of each allocated scope (indexed by scope, entry zero is the root)
+        static ::std::vector<unsigned int> s_scope_parents;
 
-        ::std::vector<unsigned int> contexts;
+        unsigned int    m_scope;
 
-        Hygiene(unsigned int index):
-            contexts({index})
+        Hygiene(unsigned int scope):
+            m_scope(scope)
         {}
+        static unsigned int alloc_scope(unsigned int parent);
     public:
         Hygiene():
-            contexts({})
+            m_scope(0)
         {}
 
         static Hygiene new_scope()
         {
-            return Hygiene(++g_next_scope);
+            return Hygiene(alloc_scope(0));
         }
         static Hygiene new_scope_chained(const Hygiene& parent)
         {
-            Hygiene rv;
-            rv.contexts.reserve( parent.contexts.size() + 1 );
-            rv.contexts.insert( rv.contexts.begin(),  parent.contexts.begin(), parent.contexts.end() );
-            rv.contexts.push_back( ++g_next_scope );
-            return rv;
+            return Hygiene(alloc_scope(parent.m_scope));
         }
         Hygiene get_parent() const
         {
-            //assert(this->contexts.size() > 1);
-            Hygiene rv;
-            rv.contexts.insert(rv.contexts.begin(),  this->contexts.begin(), this->contexts.end()-1);
-            return rv;
+            return Hygiene(s_scope_parents[m_scope]);
         }
 
         Hygiene(Hygiene&& x) = default;
@@ -59,17 +58,21 @@ struct Ident
     };
 
     Hygiene hygiene;
-    ::std::string   name;
+    RcString    name;
 
     Ident(const char* name):
         hygiene(),
         name(name)
     { }
-    Ident(::std::string name):
+    Ident(RcString name):
         hygiene(),
         name(::std::move(name))
     { }
-    Ident(Hygiene hygiene, ::std::string name):
+    Ident(const ::std::string& name):
+        hygiene(),
+        name(name)
+    { }
+    Ident(Hygiene hygiene, RcString name):
         hygiene(::std::move(hygiene)), name(::std::move(name))
     { }
 
@@ -79,7 +82,7 @@ struct Ident
     Ident& operator=(const Ident& x) = default;
 
     ::std::string into_string() {
-        return ::std::move(name);
+        return name.str();
     }
 
     bool operator==(const char* s) const {
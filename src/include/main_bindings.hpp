@@ -5,6 +5,7 @@
 
 #include <string>
 #include <memory>
+#include "dump_filter.hpp"
 
 namespace AST {
     class Crate;
@@ -26,7 +27,7 @@ extern AST::Flat Convert_Flatten(const AST::Crate& crate);
 
 
 /// Dump the crate as annotated rust
-extern void Dump_Rust(const char *Filename, const AST::Crate& crate);
+extern void Dump_Rust(::std::ostream& sink, const AST::Crate& crate, const DumpFilter& filter);
 
 #endif
 
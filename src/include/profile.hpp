@@ -0,0 +1,52 @@
+/*
+ * MRustC - Rust Compiler
+ * - By John Hodge (Mutabah/thePowersGang)
+ *
+ * include/profile.hpp
+ * - Per-item compile time profiling (`--profile <file>`)
+ */
+#pragma once
+
+#include <string>
+#include <sstream>
+
+/// Set when `--profile` is passed, all profiling is skipped otherwise
+extern bool g_profile_enabled;
+
+/// Records the time spent on a single item (e.g. typechecking one function) within a phase
+///
+/// The item name is only formatted when profiling is enabled. Scopes can nest (e.g. a macro invoked while
+/// expanding another), and the recorded time includes any nested scopes.
+class ProfileScope
+{
+    const char* m_category;
+    ::std::string   m_name;
+    unsigned long long  m_start_us;
+    unsigned int    m_count;
+    ProfileScope*   m_parent;
+public:
+    template<typename Fcn>
+    ProfileScope(const char* category, Fcn name_cb):
+        m_category(nullptr)
+    {
+        if( g_profile_enabled )
+        {
+            ::std::stringstream ss;
+            name_cb(ss);
+            this->start(category, ss.str());
+        }
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+    ~ProfileScope();
+
+    /// Add to the counter (e.g. solver iterations) of the innermost active scope on this thread
+    static void add_count(unsigned int count);
+private:
+    void start(const char* category, ::std::string name);
+};
+
+#define PROFILE_ITEM(category, name)    ProfileScope __profile_item(category, [&](::std::ostream& os) { os << name; })
+
+/// Write the recorded events as a Chrome trace (`chrome://tracing`) and print the `top_n` slowest items of each category
+extern void Profile_Write(const ::std::string& trace_filename, unsigned int top_n);
@@ -1,18 +1,34 @@
 /*
+ * MRustC - Rust Compiler
+ * - By John Hodge (Mutabah/thePowersGang)
+ *
+ * include/rc_string.hpp
+ * - Interned (deduplicated) strings, used for identifiers and filenames
  */
 #pragma once
 
 #include <cstring>
+#include <string>
 #include <ostream>
+#include <functional>
 
+/// Interned string handle
+///
+/// All strings with the same contents share a single entry in a global symbol table (which lives for the entire
+/// run), so copies are a pointer copy, equality is a pointer comparison and hashing uses the 32-bit symbol id.
 class RcString
 {
-    unsigned int*   m_ptr;
-    unsigned int    m_len;
+public:
+    struct Symbol {
+        unsigned int    id;
+        ::std::string   text;
+    };
+private:
+    const Symbol*   m_ptr;
+    static const ::std::string  s_empty_str;
 public:
     RcString():
-        m_ptr(nullptr),
-        m_len(0)
+        m_ptr(nullptr)
     {}
     RcString(const char* s, unsigned int len);
     RcString(const char* s):
@@ -24,60 +40,78 @@ public:
     {
     }
 
-    RcString(const RcString& x):
-        m_ptr(x.m_ptr),
-        m_len(x.m_len)
-    {
-        if( m_ptr ) *m_ptr += 1;
-    }
-    RcString(RcString&& x):
-        m_ptr(x.m_ptr),
-        m_len(x.m_len)
-    {
-        x.m_ptr = nullptr;
-        x.m_len = 0;
-    }
+    RcString(const RcString& x) = default;
+    RcString& operator=(const RcString& x) = default;
 
-    ~RcString();
+    /// Obtain the interned copy of the given string (same as the constructors, provided for readability)
+    static RcString new_interned(const ::std::string& s) { return RcString(s); }
+    static RcString new_interned(const char* s) { return RcString(s); }
 
-    RcString& operator=(const RcString& x)
-    {
-        if( &x != this )
-        {
-            this->~RcString();
-            m_ptr = x.m_ptr;
-            m_len = x.m_len;
-            if( m_ptr ) *m_ptr += 1;
-        }
-        return *this;
+    /// Number of distinct strings in the global table
+    static unsigned int symbol_count();
+
+    /// 32-bit symbol id (zero for the empty string)
+    unsigned int id() const {
+        return m_ptr ? m_ptr->id : 0;
     }
-    RcString& operator=(RcString&& x)
-    {
-        if( &x != this )
-        {
-            this->~RcString();
-            m_ptr = x.m_ptr;
-            m_len = x.m_len;
-            x.m_ptr = nullptr;
-            x.m_len = 0;
-        }
-        return *this;
+    unsigned int size() const {
+        return m_ptr ? m_ptr->text.size() : 0;
+    }
+    bool empty() const {
+        return m_ptr == nullptr;
     }
 
-
+    char operator[](unsigned int i) const {
+        return this->str()[i];
+    }
     const char* c_str() const {
-        if( m_len > 0 )
-        {
-            return reinterpret_cast<const char*>(m_ptr + 1);
-        }
-        else
-        {
-            return "";
-        }
+        return m_ptr ? m_ptr->text.c_str() : "";
+    }
+    const ::std::string& str() const {
+        return m_ptr ? m_ptr->text : s_empty_str;
     }
-    bool operator==(const RcString& s) const { return *this == s.c_str(); }
+    operator const ::std::string&() const {
+        return this->str();
+    }
+
+    bool operator==(const RcString& s) const { return m_ptr == s.m_ptr; }
+    bool operator!=(const RcString& s) const { return m_ptr != s.m_ptr; }
     bool operator==(const char* s) const;
+    bool operator!=(const char* s) const { return !(*this == s); }
+    bool operator==(const ::std::string& s) const { return this->str() == s; }
+    bool operator!=(const ::std::string& s) const { return this->str() != s; }
+    friend bool operator==(const ::std::string& a, const RcString& b) { return b == a; }
+    friend bool operator!=(const ::std::string& a, const RcString& b) { return b != a; }
+    friend bool operator==(const char* a, const RcString& b) { return b == a; }
+    friend bool operator!=(const char* a, const RcString& b) { return b != a; }
+
+    // NOTE: Ordering is by string contents, so sorted output does not depend on interning order
+    bool operator<(const RcString& s) const { return m_ptr != s.m_ptr && this->str() < s.str(); }
+    bool operator>(const RcString& s) const { return s < *this; }
+    bool operator<=(const RcString& s) const { return !(s < *this); }
+    bool operator>=(const RcString& s) const { return !(*this < s); }
+    bool operator<(const ::std::string& s) const { return this->str() < s; }
+    bool operator<(const char* s) const { return this->str() < s; }
+
+    /// Append (interns the new string)
+    RcString& operator+=(const char* s) { return *this = RcString(this->str() + s); }
+
+    friend ::std::string operator+(const ::std::string& a, const RcString& b) { return a + b.str(); }
+    friend ::std::string operator+(const RcString& a, const ::std::string& b) { return a.str() + b; }
+    friend ::std::string operator+(const char* a, const RcString& b) { return a + b.str(); }
+    friend ::std::string operator+(const RcString& a, const char* b) { return a.str() + b; }
+
     friend ::std::ostream& operator<<(::std::ostream& os, const RcString& x) {
         return os << x.c_str();
     }
 };
+
+namespace std {
+    template<>
+    struct hash<RcString>
+    {
+        size_t operator()(const RcString& s) const noexcept {
+            return s.id();
+        }
+    };
+}
@@ -583,7 +583,7 @@ class MacroExpander:
     MacroExpandState    m_state;
 
     Token   m_next_token;   // used for inserting a single token into the stream
-    ::std::unique_ptr<TTStreamO> m_ttstream;
+    ::std::unique_ptr<TTStreamFlat> m_ttstream;
     Ident::Hygiene  m_hygiene;
 
 public:
@@ -754,39 +754,19 @@ InterpolatedFragment Macro_HandlePatternCap(TokenStream& lex, MacroPatEnt::Type
 // - Does very loose consuming
 namespace
 {
-    // Class that provides read-only iteration over a TokenTree
+    // Class that provides read-only iteration over a flattened TokenTree
     class TokenStreamRO
     {
-        const TokenTree& m_tt;
-        ::std::vector<size_t>   m_offsets;
-        size_t  m_active_offset;
+        const FlatTokenTree::Slice& m_tt;
+        unsigned int    m_pos;
 
         size_t  m_consume_count;
     public:
-        TokenStreamRO(const TokenTree& tt):
+        TokenStreamRO(const FlatTokenTree::Slice& tt):
             m_tt(tt),
-            m_active_offset(0),
+            m_pos(0),
             m_consume_count(0)
         {
-            assert( ! m_tt.is_token() );
-            if( m_tt.size() == 0 )
-            {
-                m_active_offset = 0;
-                DEBUG("TOK_EOF");
-            }
-            else
-            {
-                const auto* cur_tree = &m_tt;
-                while( !cur_tree->is_token() )
-                {
-                    cur_tree = &(*cur_tree)[0];
-                    m_offsets.push_back(0);
-                }
-                assert(m_offsets.size() > 0);
-                m_offsets.pop_back();
-                m_active_offset = 0;
-                DEBUG(next_tok());
-            }
         }
         TokenStreamRO clone() const {
             return TokenStreamRO(*this);
@@ -798,57 +778,31 @@ namespace
         const Token& next_tok() const {
             static Token    eof_token = TOK_EOF;
 
-            if( m_offsets.empty() && m_active_offset == m_tt.size() )
+            if( m_pos == m_tt.size() )
             {
-                //DEBUG(m_consume_count << " " << eof_token << "(EOF)");
                 return eof_token;
             }
             else
             {
-                const auto* cur_tree = &m_tt;
-                for(auto idx : m_offsets)
-                    cur_tree = &(*cur_tree)[idx];
-                const auto& rv = (*cur_tree)[m_active_offset].tok();
-                //DEBUG(m_consume_count << " " << rv);
-                return rv;
+                return m_tt[m_pos].tok;
             }
         }
         void consume()
         {
-            if( m_offsets.empty() && m_active_offset == m_tt.size() )
+            if( m_pos == m_tt.size() )
                 throw ::std::runtime_error("Attempting to consume EOS");
             DEBUG(m_consume_count << " " << next_tok());
             m_consume_count ++;
-            for(;;)
-            {
-                const auto* cur_tree = &m_tt;
-                for(auto idx : m_offsets)
-                    cur_tree = &(*cur_tree)[idx];
-
-                m_active_offset ++;
-                // If reached the end of a tree...
-                if(m_active_offset == cur_tree->size())
-                {
-                    // If the end of the root is reached, return (leaving the state indicating EOS0
-                    if( m_offsets.empty() )
-                        return ;
-                    // Pop and continue
-                    m_active_offset = m_offsets.back();
-                    m_offsets.pop_back();
-                }
-                else
-                {
-                    // Dig into nested trees
-                    while( !(*cur_tree)[m_active_offset].is_token() )
-                    {
-                        cur_tree = &(*cur_tree)[m_active_offset];
-                        m_offsets.push_back(m_active_offset);
-                        m_active_offset = 0;
-                    }
-                    DEBUG("-> " << next_tok());
-                    return ;
-                }
-            }
+            m_pos ++;
+        }
+        /// Skip over the token tree starting at the current position (a single token, or a delimited group)
+        void consume_group()
+        {
+            assert( m_pos < m_tt.size() );
+            unsigned int end = m_tt[m_pos].tree_end - m_tt.first;
+            assert( m_pos < end && end <= m_tt.size() );
+            m_consume_count += end - m_pos;
+            m_pos = end;
         }
 
         // Consumes if the current token is `ty`, otherwise doesn't and returns false
@@ -881,22 +835,10 @@ namespace
         case TOK_SQUARE_CLOSE:
             return false;
         case TOK_PAREN_OPEN:
-            lex.consume();
-            while(lex.next() != TOK_PAREN_CLOSE)
-                consume_tt(lex);
-            lex.consume();
-            break;
         case TOK_SQUARE_OPEN:
-            lex.consume();
-            while(lex.next() != TOK_SQUARE_CLOSE)
-                consume_tt(lex);
-            lex.consume();
-            break;
         case TOK_BRACE_OPEN:
-            lex.consume();
-            while(lex.next() != TOK_BRACE_CLOSE)
-                consume_tt(lex);
-            lex.consume();
+            // Groups are pre-linked to their closing token, so skip directly to the end
+            lex.consume_group();
             break;
         default:
             lex.consume();
@@ -1772,10 +1714,13 @@ unsigned int Macro_InvokeRules_MatchPattern(const Span& sp, const MacroRules& ru
         TokenStreamRO   in_stream;
     };
 
+    // Flatten the input once, all arms are matched against (and capture from) this single array
+    auto input_slice = FlatTokenTree::make_slice(mv$(input));
+
     ::std::vector<size_t>   matches;
     for(size_t i = 0; i < rules.m_rules.size(); i ++)
     {
-        auto lex = TokenStreamRO(input);
+        auto lex = TokenStreamRO(input_slice);
         auto arm_stream = MacroPatternStream(rules.m_rules[i].m_pattern);
 
         bool fail = false;
@@ -1840,6 +1785,8 @@ unsigned int Macro_InvokeRules_MatchPattern(const Span& sp, const MacroRules& ru
         {
             matches.push_back(i);
             DEBUG(i << " MATCHED");
+            // Only the first matching arm is used
+            break;
         }
         else
         {
@@ -1859,7 +1806,9 @@ unsigned int Macro_InvokeRules_MatchPattern(const Span& sp, const MacroRules& ru
         // NOTE: There can be multiple arms active, take the first.
         auto i = matches[0];
 
-        auto lex = TTStreamO(sp, mv$(input));
+        // The input is only used by this stream (and `tt` captures, which refer to ranges that are skipped over instead
+        // of being read), so tokens and interpolated fragments are moved out of it instead of cloned.
+        auto lex = TTStreamFlat(sp, mv$(input_slice), /*can_steal=*/true);
         SET_MODULE(lex, mod);
         auto arm_stream = MacroPatternStream(rules.m_rules[i].m_pattern);
 
@@ -1912,7 +1861,19 @@ unsigned int Macro_InvokeRules_MatchPattern(const Span& sp, const MacroRules& ru
             {
                 DEBUG(i << " ExpectPat(" << e->type << " => $" << e->idx << ")");
 
-                auto cap = Macro_HandlePatternCap(lex, e->type);
+                // Token trees (and idents) are captured as a reference to the input range instead of being re-parsed
+                FlatTokenTree::Slice    cap_slice;
+                if( e->type == MacroPatEnt::PAT_TT || e->type == MacroPatEnt::PAT_IDENT )
+                {
+                    cap_slice = lex.take_tt();
+                    if( cap_slice.is_valid() && e->type == MacroPatEnt::PAT_IDENT )
+                    {
+                        auto ty = cap_slice[0].tok.type();
+                        if( !(ty == TOK_IDENT || is_reserved_word(ty)) )
+                            throw ParseError::Unexpected(lex, cap_slice[0].tok, Token(TOK_IDENT));
+                    }
+                }
+                auto cap = cap_slice.is_valid() ? InterpolatedFragment(mv$(cap_slice)) : Macro_HandlePatternCap(lex, e->type);
 
                 unsigned int cap_idx = captures.size();
                 captures.push_back( mv$(cap) );
@@ -2321,14 +2282,8 @@ Token MacroExpander::realGetToken()
                 DEBUG("Insert replacement #" << e << " = " << *frag);
                 if( frag->m_type == InterpolatedFragment::TT )
                 {
-                    if( can_steal )
-                    {
-                        m_ttstream.reset( new TTStreamO(*this->outerSpan(), mv$(frag->as_tt()) ) );
-                    }
-                    else
-                    {
-                        m_ttstream.reset( new TTStreamO(*this->outerSpan(), frag->as_tt().clone() ) );
-                    }
+                    // NOTE: Captured ranges never overlap, so the last use can move tokens out of the arena
+                    m_ttstream.reset( new TTStreamFlat(*this->outerSpan(), frag->as_tt(), can_steal) );
                     return m_ttstream->getToken();
                 }
                 else
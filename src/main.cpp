@@ -7,8 +7,10 @@
  */
 #include <iostream>
 #include <iomanip>
+#include <fstream>
 #include <string>
 #include <set>
+#include <thread>    // hardware_concurrency
 #include "parse/lex.hpp"
 #include "parse/parseerror.hpp"
 #include "ast/ast.hpp"
@@ -24,6 +26,7 @@
 #include "mir/main_bindings.hpp"
 #include "trans/main_bindings.hpp"
 #include "trans/target.hpp"
+#include <profile.hpp>
 
 #include "expand/cfg.hpp"
 
@@ -42,7 +45,7 @@
 #define DEFAULT_TARGET_NAME "x86_64-linux-gnu"
 #endif
 
-int g_debug_indent_level = 0;
+thread_local int g_debug_indent_level = 0;
 bool g_debug_enabled = true;
 ::std::string g_cur_phase;
 ::std::set< ::std::string>    g_debug_disable_map;
@@ -157,22 +160,51 @@ struct ProgramParams
 
     bool test_harness = false;
 
+    // Number of worker threads for parallel passes (`-j <n>`, default is the number of CPUs)
+    unsigned num_threads = 0;
+
     ::std::vector<const char*> lib_search_dirs;
     ::std::vector<const char*> libraries;
     ::std::map<::std::string, ::std::string>    crate_overrides;    // --extern name=path
 
     ::std::set< ::std::string> features;
 
+    // `--emit-dump <stage>[.gz][:<glob>]`
+    enum eDumpStage {
+        DUMP_EXPAND,    // `_0a_exp.rs` - AST after expansion
+        DUMP_RESOLVE,   // `_1_res.rs` - AST after name resolution
+        DUMP_HIR,   // `_2_hir.rs`
+        DUMP_MIR,   // `_3_mir.rs`
+        DUMP_COUNT
+    };
+    struct DumpParams {
+        bool enabled = false;
+        bool compress = false;
+        DumpFilter  filter;
+    } dumps[DUMP_COUNT];
+
+    // `--profile <file>` - Per-item timings, written as a Chrome trace (with a summary of the `profile_top` slowest)
+    ::std::string   profile_file;
+    unsigned int    profile_top = 20;
 
     struct {
         bool disable_mir_optimisations = false;
         bool full_validate = false;
         bool full_validate_early = false;
+        bool full_teardown = false;
+        bool release_hir = false;
+        bool flat_c = false;
+        bool compact_mangling = false;
+        bool shared_c_prelude = false;
+        bool fold_identical = false;
     } debug;
 
     ProgramParams(int argc, char *argv[]);
 };
 
+/// Duration (in seconds) of the most recently completed phase
+static double g_last_phase_time;
+
 template <typename Rv, typename Fcn>
 Rv CompilePhase(const char *name, Fcn f) {
     ::std::cout << name << ": V V V" << ::std::endl;
@@ -184,7 +216,8 @@ Rv CompilePhase(const char *name, Fcn f) {
     g_cur_phase = "";
     g_debug_enabled = debug_enabled_update();
 
-    ::std::cout <<"(" << ::std::fixed << ::std::setprecision(2) << static_cast<double>(end - start) / static_cast<double>(CLOCKS_PER_SEC) << " s) ";
+    g_last_phase_time = static_cast<double>(end - start) / static_cast<double>(CLOCKS_PER_SEC);
+    ::std::cout <<"(" << ::std::fixed << ::std::setprecision(2) << g_last_phase_time << " s) ";
     ::std::cout << name << ": DONE";
     ::std::cout << ::std::endl;
     return rv;
@@ -193,6 +226,17 @@ template <typename Fcn>
 void CompilePhaseV(const char *name, Fcn f) {
     CompilePhase<int>(name, [&]() { f(); return 0; });
 }
+/// Run a dump phase, only if the dump was requested with `--emit-dump`
+template <typename Fcn>
+void DumpPhase(const char *name, const ProgramParams& params, ProgramParams::eDumpStage stage, const char* suffix, Fcn f) {
+    const auto& d = params.dumps[stage];
+    if( !d.enabled )
+        return ;
+    CompilePhaseV(name, [&]() {
+        auto os = DumpFile_Open(params.outfile + suffix, d.compress);
+        f(*os, d.filter);
+        });
+}
 
 /// main!
 int main(int argc, char *argv[])
@@ -213,12 +257,29 @@ int main(int argc, char *argv[])
         Cfg_SetFlag("test");
     }
 
+    // Write out the profile once compilation finishes (including when stopped early by `--stop-after`)
+    g_profile_enabled = params.profile_file != "";
+    struct ProfileOutput {
+        const ProgramParams& params;
+        ~ProfileOutput() {
+            if( g_profile_enabled )
+                Profile_Write(params.profile_file, params.profile_top);
+        }
+    } profile_output { params };
+
     try
     {
         // Parse the crate into AST
         AST::Crate crate = CompilePhase<AST::Crate>("Parse", [&]() {
             return Parse_Crate(params.infile);
             });
+        {
+            double mb = static_cast<double>(Lexer::total_bytes()) / (1024.0 * 1024.0);
+            ::std::cout << "Parse: " << ::std::setprecision(2) << mb << " MB";
+            if( g_last_phase_time > 0 )
+                ::std::cout << " (" << mb / g_last_phase_time << " MB/s)";
+            ::std::cout << ::std::endl;
+        }
         crate.m_test_harness = params.test_harness;
         crate.m_crate_name_suffix = params.crate_name_suffix;
 
@@ -313,8 +374,8 @@ int main(int argc, char *argv[])
         }
 
         // XXX: Dump crate before resolve
-        CompilePhaseV("Dump Expanded", [&]() {
-            Dump_Rust( FMT(params.outfile << "_0a_exp.rs").c_str(), crate );
+        DumpPhase("Dump Expanded", params, ProgramParams::DUMP_EXPAND, "_0a_exp.rs", [&](auto& os, const auto& filter) {
+            Dump_Rust( os, crate, filter );
             });
 
         if( params.last_stage == ProgramParams::STAGE_EXPAND ) {
@@ -352,8 +413,8 @@ int main(int argc, char *argv[])
             });
 
         // XXX: Dump crate before HIR
-        CompilePhaseV("Temp output - Resolved", [&]() {
-            Dump_Rust( FMT(params.outfile << "_1_res.rs").c_str(), crate );
+        DumpPhase("Temp output - Resolved", params, ProgramParams::DUMP_RESOLVE, "_1_res.rs", [&](auto& os, const auto& filter) {
+            Dump_Rust( os, crate, filter );
             });
 
         if( params.last_stage == ProgramParams::STAGE_RESOLVE ) {
@@ -392,9 +453,8 @@ int main(int argc, char *argv[])
             ConvertHIR_ConstantEvaluate(*hir_crate);
             });
 
-        CompilePhaseV("Dump HIR", [&]() {
-            ::std::ofstream os (FMT(params.outfile << "_2_hir.rs"));
-            HIR_Dump( os, *hir_crate );
+        DumpPhase("Dump HIR", params, ProgramParams::DUMP_HIR, "_2_hir.rs", [&](auto& os, const auto& filter) {
+            HIR_Dump( os, *hir_crate, filter );
             });
 
         // === Type checking ===
@@ -430,9 +490,8 @@ int main(int argc, char *argv[])
         CompilePhaseV("Expand HIR ErasedType", [&]() {
             HIR_Expand_ErasedType(*hir_crate);
             });
-        CompilePhaseV("Dump HIR", [&]() {
-            ::std::ofstream os (FMT(params.outfile << "_2_hir.rs"));
-            HIR_Dump( os, *hir_crate );
+        DumpPhase("Dump HIR", params, ProgramParams::DUMP_HIR, "_2_hir.rs", [&](auto& os, const auto& filter) {
+            HIR_Dump( os, *hir_crate, filter );
             });
         // - Ensure that typeck worked (including Fn trait call insertion etc)
         CompilePhaseV("Typecheck Expressions (validate)", [&]() {
@@ -448,9 +507,8 @@ int main(int argc, char *argv[])
             HIR_GenerateMIR(*hir_crate);
             });
 
-        CompilePhaseV("Dump MIR", [&]() {
-            ::std::ofstream os (FMT(params.outfile << "_3_mir.rs"));
-            MIR_Dump( os, *hir_crate );
+        DumpPhase("Dump MIR", params, ProgramParams::DUMP_MIR, "_3_mir.rs", [&](auto& os, const auto& filter) {
+            MIR_Dump( os, *hir_crate, filter );
             });
 
         // Validate the MIR
@@ -462,10 +520,16 @@ int main(int argc, char *argv[])
         CompilePhaseV("Constant Evaluate Full", [&]() {
             ConvertHIR_ConstantEvaluateFull(*hir_crate);
             });
-        CompilePhaseV("Dump HIR", [&]() {
-            ::std::ofstream os (FMT(params.outfile << "_2_hir.rs"));
-            HIR_Dump( os, *hir_crate );
+        DumpPhase("Dump HIR", params, ProgramParams::DUMP_HIR, "_2_hir.rs", [&](auto& os, const auto& filter) {
+            HIR_Dump( os, *hir_crate, filter );
             });
+        // - Function bodies are only used as MIR from here on, free the HIR to reduce peak memory
+        if( params.debug.release_hir )
+        {
+            CompilePhaseV("Release HIR", [&]() {
+                HIR_ReleaseLoweredCode(*hir_crate);
+                });
+        }
 
         // - Expand constants in HIR and virtualise calls
         CompilePhaseV("MIR Cleanup", [&]() {
@@ -474,7 +538,7 @@ int main(int argc, char *argv[])
         if( params.debug.full_validate_early || getenv("MRUSTC_FULL_VALIDATE_PREOPT") )
         {
             CompilePhaseV("MIR Validate Full Early", [&]() {
-                MIR_CheckCrate_Full(*hir_crate);
+                MIR_CheckCrate_Full(*hir_crate, params.num_threads);
                 });
         }
 
@@ -483,9 +547,8 @@ int main(int argc, char *argv[])
             MIR_OptimiseCrate(*hir_crate, params.debug.disable_mir_optimisations);
             });
 
-        CompilePhaseV("Dump MIR", [&]() {
-            ::std::ofstream os (FMT(params.outfile << "_3_mir.rs"));
-            MIR_Dump( os, *hir_crate );
+        DumpPhase("Dump MIR", params, ProgramParams::DUMP_MIR, "_3_mir.rs", [&](auto& os, const auto& filter) {
+            MIR_Dump( os, *hir_crate, filter );
             });
         CompilePhaseV("MIR Validate PO", [&]() {
             MIR_CheckCrate(*hir_crate);
@@ -494,7 +557,7 @@ int main(int argc, char *argv[])
         // > DEBUGGING ONLY
         CompilePhaseV("MIR Validate Full", [&]() {
             if( params.debug.full_validate || getenv("MRUSTC_FULL_VALIDATE") )
-                MIR_CheckCrate_Full(*hir_crate);
+                MIR_CheckCrate_Full(*hir_crate, params.num_threads);
             });
 
         if( params.last_stage == ProgramParams::STAGE_MIR ) {
@@ -515,6 +578,10 @@ int main(int argc, char *argv[])
             hir_crate->m_ext_libs.push_back(::HIR::ExternLibrary { libname });
         }
         trans_opt.emit_debug_info = params.emit_debug_info;
+        trans_opt.structured_c = !params.debug.flat_c;
+        trans_opt.compact_mangling = params.debug.compact_mangling;
+        trans_opt.shared_c_prelude = params.debug.shared_c_prelude;
+        trans_opt.fold_identical = params.debug.fold_identical;
 
         // Generate code for non-generic public items (if requested)
         if( params.test_harness )
@@ -528,28 +595,25 @@ int main(int argc, char *argv[])
             // ERROR?
             break;
         case ::AST::Crate::Type::RustLib: {
-            #if 1
-            // Generate a .o
-            TransList   items = CompilePhase<TransList>("Trans Enumerate", [&]() { return Trans_Enumerate_Public(*hir_crate); });
-            CompilePhaseV("Trans Codegen", [&]() { Trans_Codegen(params.outfile + ".o", trans_opt, *hir_crate, items, false); });
-            #endif
+            // NOTE: Enumeration must happen before serialisation, as it flags which function bodies are saved
+            TransList   items = CompilePhase<TransList>("Trans Enumerate", [&]() { return Trans_Enumerate_Public(*hir_crate, params.num_threads); });
 
             // Save a loadable HIR dump
-            CompilePhaseV("HIR Serialise", [&]() {
-                //HIR_Serialise(params.outfile + ".meta", *hir_crate);
-                HIR_Serialise(params.outfile, *hir_crate);
-                });
+            // - Done before codegen, so dependent crates can start compiling while this crate's C code is generated
+            //   and compiled (see minicargo)
+            CompilePhaseV("HIR Serialise", [&]() { HIR_Serialise(params.outfile, *hir_crate); });
+
+            // Generate a .o
+            CompilePhaseV("Trans Codegen", [&]() { Trans_Codegen(params.outfile + ".o", trans_opt, *hir_crate, items, false); });
 
             // Link metatdata and object into a .rlib
             break; }
         case ::AST::Crate::Type::RustDylib: {
-            #if 1
+            TransList   items = CompilePhase<TransList>("Trans Enumerate", [&]() { return Trans_Enumerate_Public(*hir_crate, params.num_threads); });
+            // Save a loadable HIR dump (before codegen, see above)
+            CompilePhaseV("HIR Serialise", [&]() { HIR_Serialise(params.outfile, *hir_crate); });
             // Generate a .o
-            TransList   items = CompilePhase<TransList>("Trans Enumerate", [&]() { return Trans_Enumerate_Public(*hir_crate); });
             CompilePhaseV("Trans Codegen", [&]() { Trans_Codegen(params.outfile + ".o", trans_opt, *hir_crate, items, false); });
-            #endif
-            // Save a loadable HIR dump
-            CompilePhaseV("HIR Serialise", [&]() { HIR_Serialise(params.outfile, *hir_crate); });
 
             // Generate a .so/.dll
             // TODO: Codegen and include the metadata in a non-loadable segment
@@ -560,12 +624,21 @@ int main(int argc, char *argv[])
         case ::AST::Crate::Type::Executable:
             // Generate a binary
             // - Enumerate items for translation
-            TransList items = CompilePhase<TransList>("Trans Enumerate", [&]() { return Trans_Enumerate_Main(*hir_crate); });
+            TransList items = CompilePhase<TransList>("Trans Enumerate", [&]() { return Trans_Enumerate_Main(*hir_crate, params.num_threads); });
             // - Perform codegen
             CompilePhaseV("Trans Codegen", [&]() { Trans_Codegen(params.outfile, trans_opt, *hir_crate, items, true); });
             // - Invoke linker?
             break;
         }
+
+        // Fast exit: skip freeing the crate (and everything it owns), the OS reclaims the memory far faster than
+        // running every destructor. `-Z full-teardown` frees everything (e.g. when checking for leaks)
+        if( !params.debug.full_teardown )
+        {
+            if( g_profile_enabled )
+                Profile_Write(params.profile_file, params.profile_top);
+            ::std::exit(0);
+        }
     }
     catch(unsigned int) {}
     //catch(const CompileError::Base& e)
@@ -637,6 +710,18 @@ ProgramParams::ProgramParams(int argc, char *argv[])
                     this->libraries.push_back( arg+1 );
                 }
                 continue ;
+            case 'j':
+                if( arg[1] == '\0' ) {
+                    if( i == argc - 1 ) {
+                        ::std::cerr << "Option " << arg << " requires an argument" << ::std::endl;
+                        exit(1);
+                    }
+                    this->num_threads = ::std::strtoul(argv[++i], nullptr, 10);
+                }
+                else {
+                    this->num_threads = ::std::strtoul(arg+1, nullptr, 10);
+                }
+                continue ;
             case 'Z': {
                 ::std::string optname;
                 if( arg[1] == '\0' ) {
@@ -659,6 +744,24 @@ ProgramParams::ProgramParams(int argc, char *argv[])
                 else if( optname == "full-validate-early" ) {
                     this->debug.full_validate_early = true;
                 }
+                else if( optname == "full-teardown" ) {
+                    this->debug.full_teardown = true;
+                }
+                else if( optname == "release-hir" ) {
+                    this->debug.release_hir = true;
+                }
+                else if( optname == "flat-c" ) {
+                    this->debug.flat_c = true;
+                }
+                else if( optname == "compact-mangling" ) {
+                    this->debug.compact_mangling = true;
+                }
+                else if( optname == "shared-c-prelude" ) {
+                    this->debug.shared_c_prelude = true;
+                }
+                else if( optname == "fold-identical" ) {
+                    this->debug.fold_identical = true;
+                }
                 else {
                     ::std::cerr << "Unknown debug option: '" << optname << "'" << ::std::endl;
                     exit(1);
@@ -833,6 +936,63 @@ ProgramParams::ProgramParams(int argc, char *argv[])
             else if( strcmp(arg, "--test") == 0 ) {
                 this->test_harness = true;
             }
+            // `--emit-dump <stage>[.gz][:<item-glob>]` - Write a pretty-printed dump of the crate at the given stage
+            // - Stages: `expand`, `resolve`, `hir`, `mir`
+            // - `.gz` compresses the output, `<item-glob>` limits the dump to items with matching paths
+            else if( strcmp(arg, "--emit-dump") == 0 || strncmp(arg, "--emit-dump=", 12) == 0 ) {
+                const char* spec;
+                if( arg[11] == '=' ) {
+                    spec = arg + 12;
+                }
+                else {
+                    if( i == argc - 1 ) {
+                        ::std::cerr << "Flag " << arg << " requires an argument" << ::std::endl;
+                        exit(1);
+                    }
+                    spec = argv[++i];
+                }
+                const char* glob_sep = ::std::strchr(spec, ':');
+                ::std::string   stage_str = glob_sep ? ::std::string(spec, glob_sep) : ::std::string(spec);
+                bool compress = false;
+                if( stage_str.size() > 3 && stage_str.compare(stage_str.size() - 3, 3, ".gz") == 0 ) {
+                    compress = true;
+                    stage_str.resize(stage_str.size() - 3);
+                }
+
+                eDumpStage  stage;
+                if( stage_str == "expand" )
+                    stage = DUMP_EXPAND;
+                else if( stage_str == "resolve" )
+                    stage = DUMP_RESOLVE;
+                else if( stage_str == "hir" )
+                    stage = DUMP_HIR;
+                else if( stage_str == "mir" )
+                    stage = DUMP_MIR;
+                else {
+                    ::std::cerr << "Unknown stage for --emit-dump : '" << stage_str << "'" << ::std::endl;
+                    exit(1);
+                }
+                auto& d = this->dumps[stage];
+                d.enabled = true;
+                d.compress = compress;
+                d.filter = glob_sep ? DumpFilter(glob_sep + 1) : DumpFilter();
+            }
+            // `--profile <file>`    - Record the time spent on each item (macro, function) in the expensive phases
+            // - Writes a Chrome trace-event file, and prints the slowest items (`--profile-top <n>`, default 20)
+            else if( strcmp(arg, "--profile") == 0 ) {
+                if( i == argc - 1 ) {
+                    ::std::cerr << "Flag " << arg << " requires an argument" << ::std::endl;
+                    exit(1);
+                }
+                this->profile_file = argv[++i];
+            }
+            else if( strcmp(arg, "--profile-top") == 0 ) {
+                if( i == argc - 1 ) {
+                    ::std::cerr << "Flag " << arg << " requires an argument" << ::std::endl;
+                    exit(1);
+                }
+                this->profile_top = ::std::strtoul(argv[++i], nullptr, 10);
+            }
             else {
                 ::std::cerr << "Unknown option '" << arg << "'" << ::std::endl;
                 exit(1);
@@ -845,6 +1005,11 @@ ProgramParams::ProgramParams(int argc, char *argv[])
         ::std::cerr << "No input file passed" << ::std::endl;
         exit(1);
     }
+
+    if( this->num_threads == 0 )
+    {
+        this->num_threads = ::std::max(1u, ::std::thread::hardware_concurrency());
+    }
 }
 
 
@@ -11,10 +11,18 @@
 #include <hir_typeck/static.hpp>
 #include <mir/helpers.hpp>
 #include <mir/visit_crate_mir.hpp>
+#include <cstdlib>    // getenv/strtoull
+#include <thread>
+#include <atomic>
 
 // DISABLED: Unsizing intentionally leaks
 #define ENABLE_LEAK_DETECTOR    0
 
+// Per-function budget (number of basic block visits), after which validation is abandoned with a warning
+// - Deterministic (unlike a time limit), so the same functions are checked on every machine
+// - Can be overridden with `MRUSTC_FULL_VALIDATE_BUDGET`
+#define BUDGET_MAX_BLOCK_VISITS 1000000
+
 namespace
 {
     struct State
@@ -96,63 +104,67 @@ namespace
             for(const auto& isl : this->inner_states)
                 rv.inner_states.push_back( H::clone_state_list(isl) );
             rv.bb_path = this->bb_path;
-            return *this;
+            return rv;
         }
 
-        bool is_equivalent_to(const ValueStates& x) const
+        /// Merge the state from another path into this one (a value is only valid if it's valid on both paths)
+        /// Returns true if this state changed
+        bool merge_from(const ::MIR::TypeResolve& mir_res, const ValueStates& x)
         {
-            struct H {
-                static bool equal(const ValueStates& vss_a, const State& a,  const ValueStates& vss_b, const State& b)
-                {
-                    if( a.index == 0 )
-                    {
-                        return b.index == 0;
-                    }
-                    if( a.index == ~0u )
-                    {
-                        return b.index == ~0u;
-                    }
-                    if( b.index == 0 || b.index == ~0u )
-                    {
-                        return false;
-                    }
+            assert(this->drop_flags == x.drop_flags);
+            bool changed = false;
+            changed |= this->merge_state(mir_res, this->return_value, x, x.return_value);
 
-                    const auto& states_a = vss_a.inner_states.at( a.index - 1 );
-                    const auto& states_b = vss_b.inner_states.at( b.index - 1 );
-                    // NOTE: If there's two differen variants, this can happen.
-                    if( states_a.size() != states_b.size() )
-                        return false;
-
-                    for(size_t i = 0; i < states_a.size(); i ++)
-                    {
-                        if( ! H::equal(vss_a, states_a[i],  vss_b, states_b[i]) )
-                            return false;
-                    }
-                    // If the above loop didn't early exit, the two states are equal
-                    return true;
-                }
-            };
+            assert(args.size() == x.args.size());
+            for(size_t i = 0; i < args.size(); i ++)
+                changed |= this->merge_state(mir_res, this->args[i], x, x.args[i]);
 
-            if( this->drop_flags != x.drop_flags )
+            assert(locals.size() == x.locals.size());
+            for(size_t i = 0; i < locals.size(); i ++)
+                changed |= this->merge_state(mir_res, this->locals[i], x, x.locals[i]);
+            return changed;
+        }
+    private:
+        bool merge_state(const ::MIR::TypeResolve& mir_res, State& s, const ValueStates& x, const State& xs)
+        {
+            // Already invalid, stays invalid
+            if( !s.is_valid() )
                 return false;
-            if( ! H::equal(*this, return_value,  x, x.return_value) )
+            if( !xs.is_valid() )
+            {
+                this->clear_state(mir_res, s);
+                s = State(false);
+                return true;
+            }
+            // Other is fully valid, this can only be the same or less valid
+            if( !xs.is_composite() )
                 return false;
 
-            assert(args.size() == x.args.size());
-            for(size_t i = 0; i < args.size(); i ++)
+            const auto& x_states = x.get_composite(mir_res, xs);
+            bool changed = false;
+            if( !s.is_composite() )
             {
-                if( ! H::equal(*this, args[i],  x, x.args[i]) )
-                    return false;
+                // Fully valid, split into a composite to merge with the other side's fields
+                s = this->allocate_composite(x_states.size(), s);
+                changed = true;
             }
-
-            assert(locals.size() == x.locals.size());
-            for(size_t i = 0; i < locals.size(); i ++)
+            else if( this->get_composite(mir_res, s).size() != x_states.size() )
             {
-                if( ! H::equal(*this, locals[i],  x, x.locals[i]) )
-                    return false;
+                // Different variants on each path (e.g. after a downcast), can't be known to be valid
+                this->clear_state(mir_res, s);
+                s = State(false);
+                return true;
             }
-            return true;
+            for(size_t i = 0; i < x_states.size(); i ++)
+            {
+                // NOTE: The sub-state is moved out while merging, as the merge can allocate (invalidating references)
+                auto sub = mv$(this->get_composite(mir_res, s)[i]);
+                changed |= this->merge_state(mir_res, sub, x, x_states[i]);
+                this->get_composite(mir_res, s)[i] = mv$(sub);
+            }
+            return changed;
         }
+    public:
 
         StateFmt fmt_state(const ::MIR::TypeResolve& mir_res, const ::MIR::LValue& lv) const {
             return StateFmt(*this, get_lvalue_state(mir_res, lv));
@@ -665,20 +677,33 @@ namespace
     };
 
 
+    /// Entry states for a basic block
+    ///
+    /// States arriving from different paths are merged, only keeping separate states for each combination of drop
+    /// flags (as those decide which values a `Drop` touches).
     struct StateSet
     {
         ::std::vector<ValueStates>   known_state_sets;
 
-        bool add_state(const ValueStates& state_set)
+        /// Merge a new incoming state into the set
+        /// Returns false if nothing changed, otherwise updates `state` to be the merged state (retaining its path)
+        bool merge_state(const ::MIR::TypeResolve& mir_res, ValueStates& state)
         {
-            for(const auto& s : this->known_state_sets)
+            for(auto& s : this->known_state_sets)
             {
-                if( s.is_equivalent_to(state_set) )
+                if( s.drop_flags == state.drop_flags )
                 {
-                    return false;
+                    if( !s.merge_from(mir_res, state) )
+                    {
+                        return false;
+                    }
+                    auto bb_path = mv$(state.bb_path);
+                    state = s.clone();
+                    state.bb_path = mv$(bb_path);
+                    return true;
                 }
             }
-            this->known_state_sets.push_back( state_set.clone() );
+            this->known_state_sets.push_back( state.clone() );
             this->known_state_sets.back().bb_path = ::std::vector<unsigned int>();
             return true;
         }
@@ -734,11 +759,15 @@ namespace std {
 
 
 // "Executes" the function, keeping track of drop flags and variable validities
+// - Worklist over basic blocks, merging states at block entry until a fixed point is reached
 void MIR_Validate_FullValState(::MIR::TypeResolve& mir_res, const ::MIR::Function& fcn)
 {
-    // TODO: Use a timer to check elapsed CPU time in this function, and check on each iteration
-    // - If more than `n` (10?) seconds passes on one function, warn and abort
-    //ElapsedTimeCounter    timer;
+    static const size_t max_block_visits = []()->size_t {
+        const char* s = getenv("MRUSTC_FULL_VALIDATE_BUDGET");
+        return s ? ::std::strtoull(s, nullptr, 10) : BUDGET_MAX_BLOCK_VISITS;
+        }();
+    size_t  n_block_visits = 0;
+
     ::std::vector<StateSet> block_entry_states( fcn.blocks.size() );
 
     // Determine value lifetimes (BBs in which Copy values are valid)
@@ -768,6 +797,14 @@ void MIR_Validate_FullValState(::MIR::TypeResolve& mir_res, const ::MIR::Functio
         auto state = mv$(todo_queue.back().second);
         todo_queue.pop_back();
 
+        n_block_visits ++;
+        if( n_block_visits > max_block_visits )
+        {
+            mir_res.set_cur_stmt(cur_block, 0);
+            WARNING(mir_res.sp, W0000, "Full MIR validation abandoned, budget exceeded (" << n_block_visits << " block visits) - " << mir_res);
+            return ;
+        }
+
         // Mask off any values which aren't valid in the first statement of this block
         {
             for(unsigned i = 0; i < state.locals.size(); i ++)
@@ -793,8 +830,8 @@ void MIR_Validate_FullValState(::MIR::TypeResolve& mir_res, const ::MIR::Functio
             }
         }
 
-        // If this state already exists in the map, skip
-        if( ! block_entry_states[cur_block].add_state(state) )
+        // Merge with the known states for this block, if there's no change then skip
+        if( ! block_entry_states[cur_block].merge_state(mir_res, state) )
         {
             DEBUG("BB" << cur_block << " - Nothing new");
             continue ;
@@ -1035,13 +1072,67 @@ void MIR_Validate_Full(const StaticTraitResolve& resolve, const ::HIR::ItemPath&
 
 // --------------------------------------------------------------------
 
-void MIR_CheckCrate_Full(/*const*/ ::HIR::Crate& crate)
+void MIR_CheckCrate_Full(/*const*/ ::HIR::Crate& crate, unsigned num_threads)
 {
-    ::MIR::OuterVisitor    ov(crate, [](const auto& res, const auto& p, auto& expr, const auto& args, const auto& ty)
+    // Collect all MIR bodies first, then check them across worker threads
+    struct Job {
+        ::std::string   path;
+        const ::MIR::Function*  fcn;
+        const ::HIR::Function::args_t*  args;
+        ::HIR::TypeRef  ret_type;
+        ::HIR::GenericParams*   impl_generics;
+        ::HIR::GenericParams*   item_generics;
+    };
+    static const ::HIR::Function::args_t    empty_args;
+    ::std::vector<Job>  jobs;
+    ::MIR::OuterVisitor    ov(crate, [&](const auto& res, const auto& p, auto& expr, const auto& args, const auto& ty)
         {
-            MIR_Validate_Full(res, p, *expr.m_mir, args, ty);
+            // NOTE: Non-empty argument lists are always the function's own (which outlives this pass), empty ones
+            // can be temporaries.
+            jobs.push_back(Job { FMT(p), &*expr.m_mir, args.empty() ? &empty_args : &args, ty.clone(), res.m_impl_generics, res.m_item_generics });
         }
         );
     ov.visit_crate( crate );
+
+    // Debug output isn't thread-safe, so only use one thread when it's enabled
+    if( num_threads == 0 || debug_enabled() )
+        num_threads = 1;
+    ::std::atomic<size_t>   next_job { 0 };
+    auto worker = [&]() {
+        // Each worker has its own resolve (it caches results)
+        StaticTraitResolve  resolve { crate };
+        for(size_t i; (i = next_job++) < jobs.size(); )
+        {
+            const auto& job = jobs[i];
+            TRACE_FUNCTION_F(job.path);
+            auto check = [&]() {
+                Span    sp;
+                ::MIR::TypeResolve   state { sp, resolve, FMT_CB(ss, ss << job.path;), job.ret_type, *job.args, *job.fcn };
+                MIR_Validate_FullValState(state, *job.fcn);
+                };
+            auto check_with_item = [&]() {
+                if( job.item_generics ) {
+                    auto _ = resolve.set_item_generics(*job.item_generics);
+                    check();
+                }
+                else {
+                    check();
+                }
+                };
+            if( job.impl_generics ) {
+                auto _ = resolve.set_impl_generics(*job.impl_generics);
+                check_with_item();
+            }
+            else {
+                check_with_item();
+            }
+        }
+        };
+    ::std::vector< ::std::thread>   threads;
+    for(unsigned i = 1; i < num_threads; i ++)
+        threads.push_back( ::std::thread(worker) );
+    worker();
+    for(auto& t : threads)
+        t.join();
 }
 
@@ -219,6 +219,23 @@ const ::HIR::Literal* MIR_Cleanup_GetConstant(const Span& sp, const StaticTraitR
         return ::MIR::RValue::make_Tuple({ mv$(lvals) });
         ),
     (Array,
+        if( const auto* le = lit.opt_Repeat() )
+        {
+            MIR_ASSERT(state, le->count == te.size_val, "Literal size mismatched with array size");
+            auto rval = MIR_Cleanup_LiteralToRValue(state, mutator, *le->val, te.inner->clone(), ::HIR::GenericPath());
+            auto data_lval = mutator.in_temporary(te.inner->clone(), mv$(rval));
+            return ::MIR::RValue::make_SizedArray({ mv$(data_lval), static_cast<unsigned int>(te.size_val) });
+        }
+        if( const auto* le = lit.opt_Bytes() )
+        {
+            MIR_ASSERT(state, le->size() == te.size_val, "Literal size mismatched with array size");
+            MIR_ASSERT(state, *te.inner == ::HIR::CoreType::U8, "Bytes literal for non-u8 array - " << ty);
+            ::std::vector< ::MIR::Param>   lvals;
+            lvals.reserve( le->size() );
+            for(auto b : *le)
+                lvals.push_back( ::MIR::Constant::make_Uint({ b, ::HIR::CoreType::U8 }) );
+            return ::MIR::RValue::make_Array({ mv$(lvals) });
+        }
         MIR_ASSERT(state, lit.is_List(), "Non-list literal for Array - " << lit);
         const auto& vals = lit.as_List();
 
@@ -393,8 +410,8 @@ const ::HIR::Literal* MIR_Cleanup_GetConstant(const Span& sp, const StaticTraitR
             // 2. Borrow that slot
             if( const auto* tie = te.inner->m_data.opt_Slice() )
             {
-                MIR_ASSERT(state, inner_lit.is_List(), "BorrowData of non-list resulting in &[T]");
-                auto size = inner_lit.as_List().size();
+                MIR_ASSERT(state, inner_lit.is_List() || inner_lit.is_Repeat() || inner_lit.is_Bytes(), "BorrowData of non-list resulting in &[T]");
+                auto size = inner_lit.list_size();
                 auto inner_ty = ::HIR::TypeRef::new_array(tie->inner->clone(), size);
                 auto size_val = ::MIR::Param( ::MIR::Constant::make_Uint({ size, ::HIR::CoreType::Usize }) );
                 auto ptr_ty = ::HIR::TypeRef::new_borrow(te.type, inner_ty.clone());
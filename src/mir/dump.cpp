@@ -409,15 +409,25 @@ namespace {
         unsigned int    m_indent_level;
         bool m_short_item_name = false;
 
+        const DumpFilter&   m_filter;
+        // Set when within an item selected by the filter (e.g. a trait)
+        bool m_in_selected = false;
+
     public:
-        TreeVisitor(::std::ostream& os):
+        TreeVisitor(::std::ostream& os, const DumpFilter& filter):
             m_os(os),
-            m_indent_level(0)
+            m_indent_level(0),
+            m_filter(filter)
         {
         }
 
         void visit_type_impl(::HIR::TypeImpl& impl) override
         {
+            // When filtering, impl blocks are not printed (items are printed with their full path)
+            if( !m_filter.is_all() ) {
+                ::HIR::Visitor::visit_type_impl(impl);
+                return ;
+            }
             m_short_item_name = true;
 
             m_os << indent() << "impl" << impl.m_params.fmt_args() << " " << impl.m_type << "\n";
@@ -435,6 +445,10 @@ namespace {
         }
         virtual void visit_trait_impl(const ::HIR::SimplePath& trait_path, ::HIR::TraitImpl& impl) override
         {
+            if( !m_filter.is_all() ) {
+                ::HIR::Visitor::visit_trait_impl(trait_path, impl);
+                return ;
+            }
             m_short_item_name = true;
 
             m_os << indent() << "impl" << impl.m_params.fmt_args() << " " << trait_path << impl.m_trait_args << " for " << impl.m_type << "\n";
@@ -452,6 +466,8 @@ namespace {
         }
         void visit_marker_impl(const ::HIR::SimplePath& trait_path, ::HIR::MarkerImpl& impl) override
         {
+            if( !m_filter.is_all() )
+                return ;
             m_short_item_name = true;
 
             m_os << indent() << "impl" << impl.m_params.fmt_args() << " " << (impl.is_positive ? "" : "!") << trait_path << impl.m_trait_args << " for " << impl.m_type << "\n";
@@ -467,6 +483,10 @@ namespace {
         // - Type Items
         void visit_trait(::HIR::ItemPath p, ::HIR::Trait& item) override
         {
+            if( !this->select_item(p) )
+                return ;
+            auto saved_in_selected = m_in_selected;
+            m_in_selected = true;
             m_short_item_name = true;
 
             m_os << indent() << "trait " << p << item.m_params.fmt_args() << "\n";
@@ -481,10 +501,13 @@ namespace {
             m_os << indent() << "}\n";
 
             m_short_item_name = false;
+            m_in_selected = saved_in_selected;
         }
 
         void visit_function(::HIR::ItemPath p, ::HIR::Function& item) override
         {
+            if( !this->select_item(p) )
+                return ;
             m_os << indent();
             if( item.m_const )
                 m_os << "const ";
@@ -511,7 +534,7 @@ namespace {
                 m_os << indent() << " " << item.m_params.fmt_bounds() << "\n";
             }
 
-            if( item.m_code )
+            if( item.m_code.is_local() )
             {
                 m_os << indent() << "{\n";
                 inc_indent();
@@ -526,6 +549,8 @@ namespace {
         }
         void visit_constant(::HIR::ItemPath p, ::HIR::Constant& item) override
         {
+            if( !this->select_item(p) )
+                return ;
             m_os << indent();
             m_os << "const ";
             if( m_short_item_name )
@@ -550,6 +575,8 @@ namespace {
         }
         void visit_static(::HIR::ItemPath p, ::HIR::Static& item) override
         {
+            if( !this->select_item(p) )
+                return ;
             m_os << indent();
             m_os << "static ";
             if( m_short_item_name )
@@ -574,6 +601,14 @@ namespace {
         }
 
     private:
+        bool select_item(const ::HIR::ItemPath& p) const {
+            if( m_filter.is_all() || m_in_selected )
+                return true;
+            ::std::stringstream ss;
+            ss << p;
+            return m_filter.matches(ss.str());
+        }
+
         RepeatLitStr indent() const {
             return RepeatLitStr { "   ", static_cast<int>(m_indent_level) };
         }
@@ -586,9 +621,9 @@ namespace {
     };
 }
 
-void MIR_Dump(::std::ostream& sink, const ::HIR::Crate& crate)
+void MIR_Dump(::std::ostream& sink, const ::HIR::Crate& crate, const DumpFilter& filter)
 {
-    TreeVisitor tv { sink };
+    TreeVisitor tv { sink, filter };
 
     tv.visit_crate( const_cast< ::HIR::Crate&>(crate) );
 }
@@ -17,6 +17,7 @@
 #include "from_hir.hpp"
 #include "operations.hpp"
 #include <mir/visit_crate_mir.hpp>
+#include <profile.hpp>
 
 
 namespace {
@@ -2361,6 +2362,7 @@ namespace {
 ::MIR::FunctionPointer LowerMIR(const StaticTraitResolve& resolve, const ::HIR::ItemPath& path, const ::HIR::ExprPtr& ptr, const ::HIR::Function::args_t& args)
 {
     TRACE_FUNCTION;
+    PROFILE_ITEM("mir-lower", path);
 
     ::MIR::Function fcn;
     fcn.locals.reserve(ptr.m_bindings.size());
@@ -2414,3 +2416,26 @@ void HIR_GenerateMIR(::HIR::Crate& crate)
     ov.visit_crate(crate);
 }
 
+// Free the HIR expression trees of functions that have been lowered to MIR (everything after this point only uses MIR)
+// - Constants and statics are kept (they're small, and are still used by constant evaluation)
+void HIR_ReleaseLoweredCode(::HIR::Crate& crate)
+{
+    struct Visitor:
+        public ::HIR::Visitor
+    {
+        size_t  count = 0;
+
+        void visit_function(::HIR::ItemPath p, ::HIR::Function& item) override
+        {
+            // NOTE: Only block bodies are released, MIR_OptimiseCrate uses non-block bodies (closures) to skip optimisation
+            if( item.m_code && item.m_code.m_mir && dynamic_cast< ::HIR::ExprNode_Block*>(item.m_code.get()) )
+            {
+                item.m_code.release_hir();
+                count ++;
+            }
+        }
+    } v;
+    v.visit_crate(crate);
+    DEBUG("Released " << v.count << " function bodies");
+}
+
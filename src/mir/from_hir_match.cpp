@@ -841,8 +841,15 @@ void PatternRulesetBuilder::append_from_lit(const Span& sp, const ::HIR::Literal
         TODO(sp, "Match erased type with literal?");
         ),
     (Array,
-        ASSERT_BUG(sp, lit.is_List(), "Matching array with non-list literal - " << lit);
-        const auto& list = lit.as_List();
+        // Compact array literals are expanded so each element can be matched
+        ::HIR::Literal  expanded;
+        if( lit.is_Repeat() || lit.is_Bytes() ) {
+            expanded = lit.clone();
+            expanded.expand_list();
+        }
+        const auto& list_lit = (expanded.is_Invalid() ? lit : expanded);
+        ASSERT_BUG(sp, list_lit.is_List(), "Matching array with non-list literal - " << lit);
+        const auto& list = list_lit.as_List();
         ASSERT_BUG(sp, e.size_val == list.size(), "Matching array with mismatched literal size - " << e.size_val << " != " << list.size());
 
         // Sequential match just like tuples.
@@ -854,8 +861,15 @@ void PatternRulesetBuilder::append_from_lit(const Span& sp, const ::HIR::Literal
         m_field_path.pop_back();
         ),
     (Slice,
-        ASSERT_BUG(sp, lit.is_List(), "Matching array with non-list literal - " << lit);
-        const auto& list = lit.as_List();
+        // Compact array literals are expanded so each element can be matched
+        ::HIR::Literal  expanded;
+        if( lit.is_Repeat() || lit.is_Bytes() ) {
+            expanded = lit.clone();
+            expanded.expand_list();
+        }
+        const auto& list_lit = (expanded.is_Invalid() ? lit : expanded);
+        ASSERT_BUG(sp, list_lit.is_List(), "Matching array with non-list literal - " << lit);
+        const auto& list = list_lit.as_List();
 
         PatternRulesetBuilder   sub_builder { this->m_resolve };
         sub_builder.m_field_path = m_field_path;
@@ -2889,10 +2903,54 @@ void MatchGenGrouped::gen_dispatch__primitive(::HIR::TypeRef ty, ::MIR::LValue v
             auto cmp_lval = m_builder.get_rval_in_if_cond(sp, ::MIR::RValue::make_BinOp({ val.clone(), ::MIR::eBinOp::EQ, mv$(test_val) }));
             m_builder.end_block( ::MIR::Terminator::make_If({  mv$(cmp_lval), arm_targets[0], def_blk }) );
         }
-        else
+        else if( te != ::HIR::CoreType::U128 && te != ::HIR::CoreType::I128 )
         {
-            // TODO: Add a SwitchInt terminator for use with this. (Or just a SwitchVal terminator?)
+            // Multiple values, emit a single SwitchValue terminator (lets the backend use a native switch)
+            // NOTE: 128-bit integers use the comparison chain below, as their values don't fit in SwitchValues
+            bool is_signed = false;
+            switch(te)
+            {
+            case ::HIR::CoreType::I8:
+            case ::HIR::CoreType::I16:
+            case ::HIR::CoreType::I32:
+            case ::HIR::CoreType::I64:
+            case ::HIR::CoreType::Isize:
+                is_signed = true;
+                break;
+            default:
+                break;
+            }
+            ::std::vector<uint64_t> values_u;
+            ::std::vector<int64_t>  values_s;
+            ::std::vector< ::MIR::BasicBlockId> targets;
+            size_t tgt_ofs = 0;
+            for(size_t i = 0; i < rules.size(); i++)
+            {
+                for(size_t j = 1; j < rules[i].size(); j ++)
+                    ASSERT_BUG(sp, arm_targets[tgt_ofs] == arm_targets[tgt_ofs+j], "Mismatched target blocks for Value match");
 
+                const auto& r = rules[i][0][ofs];
+                ASSERT_BUG(sp, r.is_Value(), "Matching without _Value pattern - " << r.tag_str());
+                const auto& re = r.as_Value();
+                if(re.is_Const())
+                    TODO(sp, "Handle Constant::Const in match");
+                if( is_signed ) {
+                    ASSERT_BUG(sp, re.is_Int(), "Signed match with non-Int value - " << re);
+                    values_s.push_back( re.as_Int().v );
+                }
+                else {
+                    ASSERT_BUG(sp, re.is_Uint(), "Unsigned match with non-Uint value - " << re);
+                    values_u.push_back( re.as_Uint().v );
+                }
+                targets.push_back( arm_targets[tgt_ofs] );
+
+                tgt_ofs += rules[i].size();
+            }
+            auto values = is_signed ? ::MIR::SwitchValues::make_Signed(mv$(values_s)) : ::MIR::SwitchValues::make_Unsigned(mv$(values_u));
+            m_builder.end_block( ::MIR::Terminator::make_SwitchValue({ mv$(val), def_blk, mv$(targets), mv$(values) }) );
+        }
+        else
+        {
             // NOTE: Rules are currently sorted
             // TODO: If there are Constant::Const values in the list, they need to come first! (with equality checks)
 
@@ -2972,12 +3030,13 @@ void MatchGenGrouped::gen_dispatch__primitive(::HIR::TypeRef ty, ::MIR::LValue v
         }
         m_builder.end_block( ::MIR::Terminator::make_Goto(def_blk) );
         } break;
-    case ::HIR::CoreType::Str:
+    case ::HIR::CoreType::Str: {
         // Remove the deref on the &str
         auto oval = mv$(val);
         auto val = mv$(*oval.as_Deref().val);
-        // NOTE: Rules are currently sorted
-        // TODO: If there are Constant::Const values in the list, they need to come first!
+        // NOTE: Rules are currently sorted (and de-duplicated), so each value maps to a single target
+        ::std::vector< ::std::string>   values;
+        ::std::vector< ::MIR::BasicBlockId> targets;
         size_t tgt_ofs = 0;
         for(size_t i = 0; i < rules.size(); i++)
         {
@@ -2989,27 +3048,15 @@ void MatchGenGrouped::gen_dispatch__primitive(::HIR::TypeRef ty, ::MIR::LValue v
             const auto& re = r.as_Value();
             if(re.is_Const())
                 TODO(sp, "Handle Constant::Const in match");
+            ASSERT_BUG(sp, re.is_StaticString(), "String match with non-string value - " << re);
 
-            // IF v < tst : def_blk
-            {
-                auto cmp_eq_blk = m_builder.new_bb_unlinked();
-                auto cmp_lval_lt = m_builder.lvalue_or_temp(sp, ::HIR::CoreType::Bool, ::MIR::RValue::make_BinOp({ val.clone(), ::MIR::eBinOp::LT, ::MIR::Param(re.clone()) }));
-                m_builder.end_block( ::MIR::Terminator::make_If({ mv$(cmp_lval_lt), def_blk, cmp_eq_blk }) );
-                m_builder.set_cur_block(cmp_eq_blk);
-            }
-
-            // IF v == tst : target
-            {
-                auto next_cmp_blk = m_builder.new_bb_unlinked();
-                auto cmp_lval_eq = m_builder.lvalue_or_temp(sp, ::HIR::CoreType::Bool, ::MIR::RValue::make_BinOp({ val.clone(), ::MIR::eBinOp::EQ, ::MIR::Param(re.clone()) }));
-                m_builder.end_block( ::MIR::Terminator::make_If({ mv$(cmp_lval_eq), arm_targets[tgt_ofs], next_cmp_blk }) );
-                m_builder.set_cur_block(next_cmp_blk);
-            }
+            values.push_back( re.as_StaticString() );
+            targets.push_back( arm_targets[tgt_ofs] );
 
             tgt_ofs += rules[i].size();
         }
-        m_builder.end_block( ::MIR::Terminator::make_Goto(def_blk) );
-        break;
+        m_builder.end_block( ::MIR::Terminator::make_SwitchValue({ mv$(val), def_blk, mv$(targets), ::MIR::SwitchValues::make_String(mv$(values)) }) );
+        } break;
     }
 }
 
@@ -1180,7 +1180,8 @@ void MIR_Helper_GetLifetimes_DetermineValueLifetime(
             return this->end == Position { ~0u, ~0u };
         }
     };
-    static unsigned NEXT_INDEX = 0;
+    // NOTE: `thread_local`, as this is called from the parallel MIR validation
+    static thread_local unsigned NEXT_INDEX = 0;
     struct State
     {
         unsigned int index = 0;
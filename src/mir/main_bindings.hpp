@@ -7,15 +7,17 @@
  */
 #pragma once
 #include <iostream>
+#include <dump_filter.hpp>
 
 namespace HIR {
 class Crate;
 }
 
 extern void HIR_GenerateMIR(::HIR::Crate& crate);
-extern void MIR_Dump(::std::ostream& sink, const ::HIR::Crate& crate);
+extern void HIR_ReleaseLoweredCode(::HIR::Crate& crate);
+extern void MIR_Dump(::std::ostream& sink, const ::HIR::Crate& crate, const DumpFilter& filter);
 extern void MIR_CheckCrate(/*const*/ ::HIR::Crate& crate);
-extern void MIR_CheckCrate_Full(/*const*/ ::HIR::Crate& crate);
+extern void MIR_CheckCrate_Full(/*const*/ ::HIR::Crate& crate, unsigned num_threads);
 
 extern void MIR_CleanupCrate(::HIR::Crate& crate);
 extern void MIR_OptimiseCrate(::HIR::Crate& crate, bool minimal_optimisations);
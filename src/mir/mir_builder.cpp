@@ -274,7 +274,15 @@ void MirBuilder::push_stmt_assign(const Span& sp, ::MIR::LValue dst, ::MIR::RVal
         }
         ),
     (Cast,
-        this->moved_lvalue(sp, e.val);
+        // Casting a fieldless enum only reads the discriminant (e.g. `*self as usize` in derived comparisons), everything
+        // else (including unsizing of `Box`/`Rc`) consumes the source.
+        bool is_enum = false;
+        this->with_val_type(sp, e.val, [&](const auto& ty){
+            is_enum = ty.m_data.is_Path() && ty.m_data.as_Path().binding.is_Enum();
+            });
+        if( !is_enum ) {
+            this->moved_lvalue(sp, e.val);
+        }
         ),
     (BinOp,
         switch(e.op)
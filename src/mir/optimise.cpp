@@ -16,6 +16,7 @@
 #include <algorithm>
 #include <iomanip>
 #include <trans/target.hpp>
+#include <profile.hpp>
 
 #include <hir/expr.hpp> // HACK
 
@@ -270,7 +271,7 @@ namespace {
             self_ty(nullptr)
         {}
 
-        t_cb_generic get_cb(const Span& sp) const {
+        MonomorphiserPP get_cb(const Span& sp) const {
             return monomorphise_type_get_cb(sp, self_ty, &impl_params, fcn_params, nullptr);
         }
     };
@@ -492,6 +493,8 @@ bool MIR_Optimise_PropagateKnownValues(::MIR::TypeResolve& state, ::MIR::Functio
 bool MIR_Optimise_UnifyTemporaries(::MIR::TypeResolve& state, ::MIR::Function& fcn);
 bool MIR_Optimise_UnifyBlocks(::MIR::TypeResolve& state, ::MIR::Function& fcn);
 bool MIR_Optimise_ConstPropagte(::MIR::TypeResolve& state, ::MIR::Function& fcn);
+bool MIR_Optimise_ConcreteTypes(::MIR::TypeResolve& state, ::MIR::Function& fcn);
+bool MIR_Optimise_ConstDropFlags(::MIR::TypeResolve& state, ::MIR::Function& fcn);
 bool MIR_Optimise_DeadDropFlags(::MIR::TypeResolve& state, ::MIR::Function& fcn);
 bool MIR_Optimise_GarbageCollect_Partial(::MIR::TypeResolve& state, ::MIR::Function& fcn);
 bool MIR_Optimise_GarbageCollect(::MIR::TypeResolve& state, ::MIR::Function& fcn);
@@ -533,6 +536,7 @@ void MIR_Optimise(const StaticTraitResolve& resolve, const ::HIR::ItemPath& path
 {
     static Span sp;
     TRACE_FUNCTION_F(path);
+    PROFILE_ITEM("mir-optimise", path);
     ::MIR::TypeResolve   state { sp, resolve, FMT_CB(ss, ss << path;), ret_type, args, fcn };
 
     bool change_happened;
@@ -545,6 +549,10 @@ void MIR_Optimise(const StaticTraitResolve& resolve, const ::HIR::ItemPath& path
         // >> Simplify call graph (removes gotos to blocks with a single use)
         MIR_Optimise_BlockSimplify(state, fcn);
 
+        // >> Remove/fold operations that only depend on (now known) types
+        //   - Mostly applies to monomorphised instances, or after a generic function is inlined
+        change_happened |= MIR_Optimise_ConcreteTypes(state, fcn);
+
         // >> Apply known constants
         change_happened |= MIR_Optimise_ConstPropagte(state, fcn);
         #if CHECK_AFTER_ALL
@@ -587,6 +595,8 @@ void MIR_Optimise(const StaticTraitResolve& resolve, const ::HIR::ItemPath& path
 
         // >> Combine Duplicate Blocks
         change_happened |= MIR_Optimise_UnifyBlocks(state, fcn);
+        // >> Replace drop flag reads that have the same value on every path
+        change_happened |= MIR_Optimise_ConstDropFlags(state, fcn);
         // >> Remove assignments of unsed drop flags
         change_happened |= MIR_Optimise_DeadDropFlags(state, fcn);
 
@@ -625,6 +635,7 @@ void MIR_Optimise(const StaticTraitResolve& resolve, const ::HIR::ItemPath& path
         MIR_Optimise_GarbageCollect_Partial(state, fcn);
         pass_num += 1;
     } while( change_happened );
+    ProfileScope::add_count(pass_num);
 
 
     #if DUMP_AFTER_DONE
@@ -2067,6 +2078,97 @@ bool MIR_Optimise_ConstPropagte(::MIR::TypeResolve& state, ::MIR::Function& fcn)
     return changed;
 }
 
+// --------------------------------------------------------------------
+// Simplify operations that only depend on types, once those types are concrete
+// - Removes drops of values without drop glue (e.g. `T = u32` in a generic function)
+// - Folds `needs_drop` and `min_align_of`, and removes calls to `forget`
+// --------------------------------------------------------------------
+bool MIR_Optimise_ConcreteTypes(::MIR::TypeResolve& state, ::MIR::Function& fcn)
+{
+    bool changed = false;
+    TRACE_FUNCTION_FR("", changed);
+
+    // NOTE: Generic/opaque types can't be decided until monomorphisation
+    auto is_concrete = [](const ::HIR::TypeRef& ty)->bool {
+        return !visit_ty_with(ty, [](const auto& t) {
+            if( t.m_data.is_Generic() || t.m_data.is_ErasedType() )
+                return true;
+            if( const auto* te = t.m_data.opt_Path() )
+                return te->binding.is_Unbound() || te->binding.is_Opaque();
+            return false;
+            });
+        };
+
+    for(auto& bb : fcn.blocks)
+    {
+        auto bbidx = &bb - &fcn.blocks.front();
+
+        for(auto it = bb.statements.begin(); it != bb.statements.end(); )
+        {
+            state.set_cur_stmt(bbidx, it - bb.statements.begin());
+            if( const auto* se = it->opt_Drop() )
+            {
+                ::HIR::TypeRef  tmp;
+                const auto& ty = state.get_lvalue_type(tmp, se->slot);
+                if( se->kind == ::MIR::eDropKind::DEEP && is_concrete(ty) && !state.m_resolve.type_needs_drop_glue(state.sp, ty) )
+                {
+                    DEBUG(state << "Drop of " << ty << " is a no-op - " << *it);
+                    it = bb.statements.erase(it);
+                    changed = true;
+                    continue ;
+                }
+            }
+            ++ it;
+        }
+
+        state.set_cur_stmt_term(bbidx);
+        if( !bb.terminator.is_Call() )
+            continue ;
+        auto& te = bb.terminator.as_Call();
+        if( !te.fcn.is_Intrinsic() )
+            continue ;
+        const auto& tef = te.fcn.as_Intrinsic();
+        if( tef.name == "needs_drop" )
+        {
+            const auto& ty = tef.params.m_types.at(0);
+            if( is_concrete(ty) )
+            {
+                bool val = state.m_resolve.type_needs_drop_glue(state.sp, ty);
+                DEBUG(state << "needs_drop<" << ty << "> = " << val);
+                bb.statements.push_back(::MIR::Statement::make_Assign({ mv$(te.ret_val), ::MIR::Constant::make_Bool({ val }) }));
+                bb.terminator = ::MIR::Terminator::make_Goto(te.ret_block);
+                changed = true;
+            }
+        }
+        else if( tef.name == "min_align_of" )
+        {
+            // Same as `align_of` (handled by ConstPropagate)
+            size_t align_val = 0;
+            if( Target_GetAlignOf(state.sp, tef.params.m_types.at(0), align_val) )
+            {
+                auto val = ::MIR::Constant::make_Uint({ align_val, ::HIR::CoreType::Usize });
+                bb.statements.push_back(::MIR::Statement::make_Assign({ mv$(te.ret_val), mv$(val) }));
+                bb.terminator = ::MIR::Terminator::make_Goto(te.ret_block);
+                changed = true;
+            }
+        }
+        else if( tef.name == "forget" )
+        {
+            // Codegen emits nothing for `forget`, the argument was already moved (so won't be dropped)
+            DEBUG(state << "Removing call to forget");
+            bb.statements.push_back(::MIR::Statement::make_Assign({ mv$(te.ret_val), ::MIR::RValue::make_Tuple({}) }));
+            bb.terminator = ::MIR::Terminator::make_Goto(te.ret_block);
+            changed = true;
+        }
+        else
+        {
+            // Ignore any other intrinsics
+        }
+    }
+
+    return changed;
+}
+
 // --------------------------------------------------------------------
 // Replace `tmp = RValue::Use()` where the temp is only used once
 // --------------------------------------------------------------------
@@ -2563,6 +2665,112 @@ bool MIR_Optimise_PropagateSingleAssignments(::MIR::TypeResolve& state, ::MIR::F
     return replacement_happend;
 }
 
+// --------------------------------------------------------------------
+// Replace reads of drop flags that have a known value on every path to the read
+// - `MIR_Optimise_ConstPropagte` only tracks flags within a single block
+// --------------------------------------------------------------------
+bool MIR_Optimise_ConstDropFlags(::MIR::TypeResolve& state, ::MIR::Function& fcn)
+{
+    if( fcn.drop_flags.empty() )
+        return false;
+    TRACE_FUNCTION;
+
+    // Possible values of each flag: bit 0 = can be clear, bit 1 = can be set (zero for blocks not yet reached)
+    typedef ::std::vector<uint8_t>  FlagStates;
+    const uint8_t   FLAG_CLEAR = 1;
+    const uint8_t   FLAG_SET = 2;
+    auto apply_set = [&](FlagStates& flags, const ::MIR::Statement::Data_SetDropFlag& se) {
+        if( se.other == ~0u ) {
+            flags[se.idx] = se.new_val ? FLAG_SET : FLAG_CLEAR;
+        }
+        else {
+            auto v = flags[se.other];
+            if( se.new_val )
+                v = ((v & FLAG_CLEAR) ? FLAG_SET : 0) | ((v & FLAG_SET) ? FLAG_CLEAR : 0);
+            flags[se.idx] = v;
+        }
+        };
+
+    // Forward dataflow, the entry state of each block is the union of all predecessors' exit states
+    ::std::vector<FlagStates>   entry_states( fcn.blocks.size() );
+    for(bool v : fcn.drop_flags)
+        entry_states[0].push_back( v ? FLAG_SET : FLAG_CLEAR );
+    ::std::vector< ::MIR::BasicBlockId> to_visit;
+    to_visit.push_back( 0 );
+    while( !to_visit.empty() )
+    {
+        auto bb = to_visit.back(); to_visit.pop_back();
+        auto flags = entry_states[bb];
+        for(const auto& stmt : fcn.blocks[bb].statements)
+        {
+            if( const auto* se = stmt.opt_SetDropFlag() )
+                apply_set(flags, *se);
+        }
+        visit_terminator_target(fcn.blocks[bb].terminator, [&](const auto& tgt) {
+            auto& dst = entry_states[tgt];
+            bool changed = false;
+            if( dst.empty() ) {
+                dst = flags;
+                changed = true;
+            }
+            else {
+                for(size_t i = 0; i < flags.size(); i ++)
+                {
+                    if( (dst[i] | flags[i]) != dst[i] ) {
+                        dst[i] |= flags[i];
+                        changed = true;
+                    }
+                }
+            }
+            if( changed )
+                to_visit.push_back(tgt);
+            });
+    }
+
+    bool changed = false;
+    for(size_t bb = 0; bb < fcn.blocks.size(); bb ++)
+    {
+        if( entry_states[bb].empty() )
+            continue ;
+        auto& flags = entry_states[bb];
+        auto& stmts = fcn.blocks[bb].statements;
+        for(auto it = stmts.begin(); it != stmts.end(); )
+        {
+            state.set_cur_stmt(bb, it - stmts.begin());
+            if( auto* se = it->opt_SetDropFlag() )
+            {
+                if( se->other != ~0u && (flags[se->other] == FLAG_SET || flags[se->other] == FLAG_CLEAR) )
+                {
+                    bool new_val = (flags[se->other] == FLAG_SET) != se->new_val;
+                    DEBUG(state << "df" << se->other << " is always " << (flags[se->other] == FLAG_SET) << " - " << *it);
+                    *it = ::MIR::Statement::make_SetDropFlag({ se->idx, new_val, ~0u });
+                    se = &it->as_SetDropFlag();
+                    changed = true;
+                }
+                apply_set(flags, *se);
+            }
+            else if( auto* se = it->opt_Drop() )
+            {
+                if( se->flag_idx != ~0u && flags[se->flag_idx] == FLAG_SET )
+                {
+                    DEBUG(state << "df" << se->flag_idx << " is always set - " << *it);
+                    se->flag_idx = ~0u;
+                    changed = true;
+                }
+                else if( se->flag_idx != ~0u && flags[se->flag_idx] == FLAG_CLEAR )
+                {
+                    DEBUG(state << "df" << se->flag_idx << " is always clear - " << *it);
+                    it = stmts.erase(it);
+                    changed = true;
+                    continue ;
+                }
+            }
+            ++ it;
+        }
+    }
+    return changed;
+}
+
 // ----------------------------------------
 // Clear all drop flags that are never read
 // ----------------------------------------
@@ -2954,7 +3162,8 @@ void MIR_OptimiseCrate(::HIR::Crate& crate, bool do_minimal_optimisation)
 {
     ::MIR::OuterVisitor ov { crate, [do_minimal_optimisation](const auto& res, const auto& p, auto& expr, const auto& args, const auto& ty)
         {
-            if( ! dynamic_cast<::HIR::ExprNode_Block*>(expr.get()) ) {
+            // NOTE: Released HIR (`-Z release-hir`) was always a block
+            if( expr && ! dynamic_cast<::HIR::ExprNode_Block*>(expr.get()) ) {
                 return ;
             }
             if( do_minimal_optimisation ) {
@@ -31,7 +31,7 @@ void MIR::OuterVisitor::visit_type(::HIR::TypeRef& ty)
 void MIR::OuterVisitor::visit_function(::HIR::ItemPath p, ::HIR::Function& item)
 {
     auto _ = this->m_resolve.set_item_generics(item.m_params);
-    if( item.m_code )
+    if( item.m_code.is_local() )
     {
         DEBUG("Function code " << p);
         // TODO: Get span without needing hir/expr.hpp
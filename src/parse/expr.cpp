@@ -1274,7 +1274,7 @@ ExprNodeP Parse_ExprMacro(TokenStream& lex, AST::Path path)
     ASSERT_BUG(lex.point_span(), path.is_trivial(), "TODO: Support path macros - " << path);
 
     Token   tok;
-    ::std::string name = path.m_class.is_Local() ? path.m_class.as_Local().name : path.nodes()[0].name();
+    ::std::string name = path.m_class.is_Local() ? path.m_class.as_Local().name : path.nodes()[0].name().str();
     ::std::string ident;
     if( GET_TOK(tok, lex) == TOK_IDENT ) {
         ident = mv$(tok.str());
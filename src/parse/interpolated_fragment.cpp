@@ -11,7 +11,7 @@ InterpolatedFragment::~InterpolatedFragment()
     {
         switch(m_type)
         {
-        case InterpolatedFragment::TT:  delete reinterpret_cast<TokenTree*>(m_ptr);  break;
+        case InterpolatedFragment::TT:  delete reinterpret_cast<FlatTokenTree::Slice*>(m_ptr);  break;
         case InterpolatedFragment::PAT: delete reinterpret_cast<AST::Pattern*>(m_ptr); break;
         case InterpolatedFragment::PATH:delete reinterpret_cast<AST::Path*>(m_ptr);    break;
         case InterpolatedFragment::TYPE:delete reinterpret_cast<TypeRef*>(m_ptr);    break;
@@ -59,7 +59,12 @@ InterpolatedFragment::InterpolatedFragment(::AST::Named<::AST::Item> v):
 }
 InterpolatedFragment::InterpolatedFragment(TokenTree v):
     m_type( InterpolatedFragment::TT ),
-    m_ptr( new TokenTree(mv$(v)) )
+    m_ptr( new FlatTokenTree::Slice(FlatTokenTree::make_slice(mv$(v))) )
+{
+}
+InterpolatedFragment::InterpolatedFragment(FlatTokenTree::Slice v):
+    m_type( InterpolatedFragment::TT ),
+    m_ptr( new FlatTokenTree::Slice(mv$(v)) )
 {
 }
 InterpolatedFragment::InterpolatedFragment(AST::Path v):
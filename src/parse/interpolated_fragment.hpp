@@ -3,9 +3,9 @@
 #pragma once
 
 #include <cassert>
+#include "tokentree.hpp"
 
 class TypeRef;
-class TokenTree;
 namespace AST {
     class Pattern;
     class Path;
@@ -41,6 +41,7 @@ public:
     InterpolatedFragment& operator=(InterpolatedFragment&& );
     //InterpolatedFragment(const InterpolatedFragment& );
     InterpolatedFragment(TokenTree );
+    InterpolatedFragment(FlatTokenTree::Slice );
     InterpolatedFragment(::AST::Pattern);
     InterpolatedFragment(::AST::Path);
     InterpolatedFragment(::TypeRef);
@@ -49,8 +50,8 @@ public:
     ~InterpolatedFragment();
     InterpolatedFragment(Type , ::AST::ExprNode*);
 
-    TokenTree& as_tt() { assert(m_type == TT); return *reinterpret_cast<TokenTree*>(m_ptr); }
-    const TokenTree& as_tt() const { assert(m_type == TT); return *reinterpret_cast<TokenTree*>(m_ptr); }
+    FlatTokenTree::Slice& as_tt() { assert(m_type == TT); return *reinterpret_cast<FlatTokenTree::Slice*>(m_ptr); }
+    const FlatTokenTree::Slice& as_tt() const { assert(m_type == TT); return *reinterpret_cast<FlatTokenTree::Slice*>(m_ptr); }
 
     friend ::std::ostream& operator<<(::std::ostream& os, const InterpolatedFragment& x);
 };
@@ -10,40 +10,55 @@
 #include "parseerror.hpp"
 #include "../common.hpp"
 #include <cassert>
+#include <fstream>
 #include <iostream>
 #include <cstdlib>  // strtol
 #include <typeinfo>
 #include <algorithm>    // std::count
+#include <cstring>  // memcmp
 #include <cctype>
 //#define TRACE_CHARS
 //#define TRACE_RAW_TOKENS
 
+uint64_t Lexer::s_total_bytes = 0;
+
 Lexer::Lexer(const ::std::string& filename):
     m_path(filename.c_str()),
     m_line(1),
     m_line_ofs(0),
-    m_istream(filename.c_str()),
+    m_cur(nullptr),
+    m_end(nullptr),
     m_last_char_valid(false),
     m_hygiene( Ident::Hygiene::new_scope() )
 {
-    if( !m_istream.is_open() )
+    // Load the entire file in one read, the lexer then works directly on the buffer
+    ::std::ifstream is(filename.c_str(), ::std::ios::in | ::std::ios::binary);
+    if( !is.is_open() )
     {
         throw ::std::runtime_error("Unable to open file '" + filename + "'");
     }
+    is.seekg(0, ::std::ios::end);
+    auto len = is.tellg();
+    is.seekg(0, ::std::ios::beg);
+    m_buffer.resize(static_cast<size_t>(len));
+    if( len > 0 && !is.read(m_buffer.data(), len) )
+    {
+        throw ::std::runtime_error("Unable to read file '" + filename + "'");
+    }
+    m_cur = m_buffer.data();
+    m_end = m_cur + m_buffer.size();
+    s_total_bytes += m_buffer.size();
+
     // Consume the BOM
-    if( this->getc_byte() == '\xef' )
+    if( m_end - m_cur >= 1 && m_cur[0] == '\xef' )
     {
-        if( this->getc_byte() != '\xbb' ) {
+        if( m_end - m_cur < 2 || m_cur[1] != '\xbb' ) {
             throw ::std::runtime_error("Incomplete BOM - missing \\xBB in second position");
         }
-        if( this->getc_byte() != '\xbf' ) {
+        if( m_end - m_cur < 3 || m_cur[2] != '\xbf' ) {
             throw ::std::runtime_error("Incomplete BOM - missing \\xBF in second position");
         }
-        m_line_ofs = 0;
-    }
-    else
-    {
-        m_istream.unget();
+        m_cur += 3;
     }
 }
 
@@ -183,16 +198,89 @@ static const struct {
   TOKENT("yield",   TOK_RWORD_YIELD),
 };
 
+namespace {
+    /// Perfect hash over the reserved words (first, middle, and last characters)
+    /// - Collision-free for the current RWORDS list, which is checked when the table is built.
+    inline unsigned int rword_hash(const char* s, size_t len)
+    {
+        return (static_cast<unsigned char>(s[0]) + static_cast<unsigned char>(s[len-1]) * 12 + static_cast<unsigned char>(s[len/2]) * 14) & 0xFF;
+    }
+    struct RwordTable
+    {
+        static const unsigned int MAX_LEN = 8;
+        signed char idx[256];
+        RwordTable()
+        {
+            ::std::fill(idx, idx + 256, -1);
+            for(unsigned int i = 0; i < LEN(RWORDS); i ++)
+            {
+                assert(RWORDS[i].len <= MAX_LEN);
+                auto h = rword_hash(RWORDS[i].chars, RWORDS[i].len);
+                if( idx[h] != -1 )
+                    throw ::std::runtime_error(FMT("BUGCHECK: Reserved word hash collision - " << RWORDS[i].chars << " and " << RWORDS[idx[h]].chars));
+                idx[h] = i;
+            }
+        }
+        /// Returns the token type for a reserved word, or TOK_NULL if not a reserved word
+        enum eTokenType lookup(const ::std::string& s) const
+        {
+            if( s.empty() || s.size() > MAX_LEN )
+                return TOK_NULL;
+            auto i = idx[rword_hash(s.data(), s.size())];
+            if( i < 0 || RWORDS[i].len != s.size() || ::std::memcmp(RWORDS[i].chars, s.data(), s.size()) != 0 )
+                return TOK_NULL;
+            return static_cast<enum eTokenType>(RWORDS[i].type);
+        }
+    };
+    const RwordTable& rword_table()
+    {
+        static RwordTable   s_table;
+        return s_table;
+    }
+
+    /// Range of TOKENMAP entries starting with each (ASCII) character
+    struct SymbolDispatch
+    {
+        struct Range {
+            unsigned char   first;
+            unsigned char   last;
+        } ranges[128];
+        SymbolDispatch()
+        {
+            for(auto& r : ranges)
+                r = Range { 0, 0 };
+            for(unsigned int i = LEN(TOKENMAP); i --; )
+            {
+                auto& r = ranges[ static_cast<unsigned char>(TOKENMAP[i].chars[0]) ];
+                if( r.first == r.last )
+                    r.last = i+1;
+                r.first = i;
+            }
+        }
+    };
+    const SymbolDispatch& symbol_dispatch()
+    {
+        static SymbolDispatch   s_table;
+        return s_table;
+    }
+}
+
 signed int Lexer::getSymbol()
 {
     Codepoint ch = this->getc();
-    // 1. lsearch for character
+    // 1. Look up the range of symbols starting with this character
     // 2. Consume as many characters as currently match
     // 3. IF: a smaller character or, EOS is hit - Return current best
+    if( ch.v >= 128 || symbol_dispatch().ranges[ch.v].first == symbol_dispatch().ranges[ch.v].last )
+    {
+        this->ungetc();
+        return 0;
+    }
+    const auto& range = symbol_dispatch().ranges[ch.v];
     unsigned ofs = 0;
     signed int best = 0;
     bool hit_eof = false;
-    for(unsigned i = 0; i < LEN(TOKENMAP); i ++)
+    for(unsigned i = range.first; i < range.last; i ++)
     {
         const char* const chars = TOKENMAP[i].chars;
         const size_t len = TOKENMAP[i].len;
@@ -307,10 +395,15 @@ Token Lexer::getTokenInt()
             }
         }
 
-        if( ch == '\n' )
-            return Token(TOK_NEWLINE);
-        if( ch.isspace() )
+        if( ch == '\n' || ch.isspace() )
         {
+            // ASCII fast path: skip the run of whitespace (including newlines) directly in the buffer
+            const char* p = m_cur;
+            while( p != m_end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') )
+                p ++;
+            this->skip_to(p);
+            if( p == m_end )
+                return Token(TOK_WHITESPACE);
             while( (ch = this->getc()).isspace() && ch != '\n' )
                 ;
             this->ungetc();
@@ -573,6 +666,24 @@ Token Lexer::getTokenInt()
             case LINECOMMENT: {
                 // Line comment
                 ::std::string   str;
+                // - `getSymbol` leaves the first character of the comment cached
+                if( m_last_char_valid && m_last_char != '\n' && m_last_char != '\r' )
+                {
+                    str += m_last_char;
+                    m_last_char_valid = false;
+                }
+                if( !m_last_char_valid )
+                {
+                    // Fast path: Scan the buffer for the end of the line
+                    const char* start = m_cur;
+                    const char* p = start;
+                    while( p != m_end && *p != '\n' && *p != '\r' )
+                        p ++;
+                    str.append(start, p);
+                    this->skip_to(p);
+                    if( p == m_end )
+                        return Token(TOK_COMMENT, str);
+                }
                 auto ch = this->getc();
                 while(ch != '\n' && ch != '\r')
                 {
@@ -586,6 +697,16 @@ Token Lexer::getTokenInt()
                 unsigned int level = 0;
                 while(true)
                 {
+                    if( !m_last_char_valid )
+                    {
+                        // Fast path: Skip over everything that can't start/end a comment
+                        const char* start = m_cur;
+                        const char* p = start;
+                        while( p != m_end && *p != '*' && *p != '/' )
+                            p ++;
+                        str.append(start, p);
+                        this->skip_to(p);
+                    }
                     ch = this->getc();
 
                     if( ch == '/' ) {
@@ -753,18 +874,33 @@ Token Lexer::getTokenInt_Identifier(Codepoint leader, Codepoint leader2)
     if( leader2 != '\0' )
         str += leader;
     auto ch = leader2 == '\0' ? leader : leader2;
+    bool hit_eof = false;
     while( issym(ch) )
     {
         str += ch;
+        if( !m_last_char_valid )
+        {
+            // ASCII fast path: take the rest of a plain identifier straight from the buffer
+            const char* start = m_cur;
+            const char* p = start;
+            while( p != m_end && (::std::isalnum(static_cast<unsigned char>(*p)) || *p == '_') )
+                p ++;
+            str.append(start, p);
+            m_line_ofs += p - start;
+            m_cur = p;
+            if( p == m_end ) {
+                hit_eof = true;
+                break;
+            }
+        }
         ch = this->getc();
     }
 
-    this->ungetc();
-    for( unsigned int i = 0; i < LEN(RWORDS); i ++ )
-    {
-        if( str < RWORDS[i].chars ) break;
-        if( str == RWORDS[i].chars )    return Token((enum eTokenType)RWORDS[i].type);
-    }
+    if( !hit_eof )
+        this->ungetc();
+    auto rword = rword_table().lookup(str);
+    if( rword != TOK_NULL )
+        return Token(rword);
     return Token(TOK_IDENT, mv$(str));
 }
 
@@ -879,11 +1015,11 @@ uint32_t Lexer::parseEscape(char enclosing)
     }
 }
 
-char Lexer::getc_byte()
+inline char Lexer::getc_byte()
 {
-    int rv = m_istream.get();
-    if( rv == EOF || m_istream.eof() )
+    if( m_cur == m_end )
         throw Lexer::EndOfFile();
+    char rv = *m_cur++;
 
     if( rv == '\n' )
     {
@@ -978,6 +1114,23 @@ Codepoint Lexer::getc_cp()
     }
 }
 
+/// Advance the read position directly to `new_cur` (used by the ASCII fast paths), updating the line/column
+void Lexer::skip_to(const char* new_cur)
+{
+    assert(!m_last_char_valid);
+    assert(m_cur <= new_cur && new_cur <= m_end);
+    for( ; m_cur != new_cur; m_cur ++ )
+    {
+        if( *m_cur == '\n' ) {
+            m_line ++;
+            m_line_ofs = 1;
+        }
+        // Column is in codepoints, so don't count UTF-8 continuation bytes
+        else if( (*m_cur & 0xC0) != 0x80 ) {
+            m_line_ofs ++;
+        }
+    }
+}
 void Lexer::ungetc()
 {
 #ifdef TRACE_CHARS
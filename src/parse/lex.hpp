@@ -9,7 +9,7 @@
 #define LEX_HPP_INCLUDED
 
 #include <string>
-#include <fstream>
+#include <vector>
 #include "tokenstream.hpp"
 
 struct Codepoint {
@@ -36,15 +36,23 @@ class Lexer:
     unsigned int m_line;
     unsigned int m_line_ofs;
 
-    ::std::ifstream m_istream;
+    // Entire source file, scanned in-place
+    ::std::vector<char> m_buffer;
+    const char* m_cur;
+    const char* m_end;
     bool    m_last_char_valid;
     Codepoint   m_last_char;
     Token   m_next_token;   // Used when lexing generated two tokens
 
     Ident::Hygiene m_hygiene;
+
+    static uint64_t s_total_bytes;
 public:
     Lexer(const ::std::string& filename);
 
+    /// Total number of source bytes loaded by all lexers (for throughput reporting)
+    static uint64_t total_bytes() { return s_total_bytes; }
+
     Position getPosition() const override;
     Ident::Hygiene realGetHygiene() const override;
     Token realGetToken() override;
@@ -65,6 +73,7 @@ private:
         m_hygiene = m_hygiene.get_parent();
     }
 
+    void skip_to(const char* new_cur);
     void ungetc();
     Codepoint getc_num();
     Codepoint getc();
@@ -112,7 +112,7 @@ AST::Path Parse_Path(TokenStream& lex, bool is_abs, eParsePathGenericMode generi
         ::AST::PathParams   params;
 
         CHECK_TOK(tok, TOK_IDENT);
-        auto component = mv$( tok.str() );
+        auto component = tok.istr();
 
         GET_TOK(tok, lex);
         if( generic_mode == PATH_GENERIC_TYPE )
@@ -87,7 +87,7 @@ AST::Pattern Parse_Pattern(TokenStream& lex, bool is_refutable)
     if( expect_bind )
     {
         CHECK_TOK(tok, TOK_IDENT);
-        auto bind_name = Ident(lex.getHygiene(), mv$(tok.str()));
+        auto bind_name = Ident(lex.getHygiene(), tok.istr());
         // If there's no '@' after it, it's a name binding only (_ pattern)
         if( GET_TOK(tok, lex) != TOK_AT )
         {
@@ -116,12 +116,12 @@ AST::Pattern Parse_Pattern(TokenStream& lex, bool is_refutable)
             break;
         // Known binding `ident @`
         case TOK_AT:
-            binding = AST::PatternBinding( Ident(lex.getHygiene(), mv$(tok.str())), bind_type/*MOVE*/, is_mut/*false*/ );
+            binding = AST::PatternBinding( Ident(lex.getHygiene(), tok.istr()), bind_type/*MOVE*/, is_mut/*false*/ );
             GET_TOK(tok, lex);  // '@'
             GET_TOK(tok, lex);  // Match lex.putback() below
             break;
         default: {  // Maybe bind
-            Ident   name = Ident(lex.getHygiene(), mv$(tok.str()));
+            Ident   name = Ident(lex.getHygiene(), tok.istr());
             // if the pattern can be refuted (i.e this could be an enum variant), return MaybeBind
             if( is_refutable ) {
                 assert(bind_type == ::AST::PatternBinding::Type::MOVE);
@@ -356,7 +356,6 @@ AST::Pattern Parse_PatternReal_Slice(TokenStream& lex, bool is_refutable)
 ::AST::Pattern::TuplePat Parse_PatternTuple(TokenStream& lex, bool is_refutable)
 {
     TRACE_FUNCTION;
-    auto sp = lex.start_span();
     Token tok;
 
     ::std::vector<AST::Pattern> leading;
@@ -98,12 +98,12 @@ bool Parse_Publicity(TokenStream& lex, bool allow_restricted=true)
                 GET_CHECK_TOK(tok, lex, TOK_IDENT);
             case TOK_RWORD_IN:
                 GET_CHECK_TOK(tok, lex, TOK_IDENT);
-                path.nodes().push_back( AST::PathNode(tok.str()) );
+                path.nodes().push_back( AST::PathNode(tok.istr()) );
                 while( LOOK_AHEAD(lex) == TOK_DOUBLE_COLON )
                 {
                     GET_TOK(tok, lex);
                     GET_CHECK_TOK(tok, lex, TOK_IDENT);
-                    path.nodes().push_back( AST::PathNode(tok.str()) );
+                    path.nodes().push_back( AST::PathNode(tok.istr()) );
                 }
                 break;
             default:
@@ -665,7 +665,6 @@ AST::Trait Parse_TraitDef(TokenStream& lex, const AST::MetaItems& meta_items)
         AST::MetaItems  item_attrs = Parse_ItemAttrs(lex);
         SET_ATTRS(lex, item_attrs);
 
-        auto ps = lex.start_span();
         {
             ::AST::MacroInvocation  inv;
             if( Parse_MacroInvocation_Opt(lex, inv) )
@@ -820,7 +819,6 @@ AST::Enum Parse_EnumDef(TokenStream& lex, const AST::MetaItems& meta_items)
     ::std::vector<AST::EnumVariant>   variants;
     while( GET_TOK(tok, lex) != TOK_BRACE_CLOSE )
     {
-        auto sp = lex.start_span();
         PUTBACK(tok, lex);
 
         AST::MetaItems  item_attrs = Parse_ItemAttrs(lex);
@@ -1295,7 +1293,7 @@ void Parse_Use_Set(TokenStream& lex, const ProtoSpan& ps, const AST::Path& base_
         }
         else {
             CHECK_TOK(tok, TOK_IDENT);
-            path = base_path + AST::PathNode(tok.str(), {});
+            path = base_path + AST::PathNode(tok.istr(), {});
             name = mv$(tok.str());
         }
 
@@ -1335,7 +1333,7 @@ void Parse_Use(TokenStream& lex, ::std::function<void(AST::UseStmt, ::std::strin
         path = AST::Path( AST::Path::TagSuper(), count, {} );
         break; }
     case TOK_IDENT:
-        path.append( AST::PathNode(mv$(tok.str()), {}) );
+        path.append( AST::PathNode(tok.istr(), {}) );
         break;
     // Leading :: is allowed and ignored for the $crate feature
     case TOK_DOUBLE_COLON:
@@ -1364,7 +1362,7 @@ void Parse_Use(TokenStream& lex, ::std::function<void(AST::UseStmt, ::std::strin
     {
         if( GET_TOK(tok, lex) == TOK_IDENT )
         {
-            path.append( AST::PathNode( mv$(tok.str()), {}) );
+            path.append( AST::PathNode( tok.istr(), {}) );
         }
         else
         {
@@ -52,6 +52,15 @@ Token::Token(enum eTokenType type):
 Token::Token(enum eTokenType type, ::std::string str):
     m_type(type),
     m_data(Data::make_String(mv$(str)))
+{
+    // Identifiers (and lifetimes) are interned, so later comparisons are cheap
+    if( type == TOK_IDENT || type == TOK_LIFETIME ) {
+        m_data = Data::make_IString( RcString(m_data.as_String()) );
+    }
+}
+Token::Token(enum eTokenType type, RcString str):
+    m_type(type),
+    m_data(Data::make_IString(mv$(str)))
 {
 }
 Token::Token(uint64_t val, enum eCoreType datatype):
@@ -151,6 +160,7 @@ Token::Token(const Token& t):
     TU_MATCH(Data, (t.m_data), (e),
     (None,  ),
     (String,    m_data = Data::make_String(e); ),
+    (IString,   m_data = Data::make_IString(e); ),
     (Integer,   m_data = Data::make_Integer(e);),
     (Float, m_data = Data::make_Float(e);),
     (Fragment, BUG(t.m_pos, "Attempted to copy a fragment - " << t);)
@@ -168,6 +178,9 @@ Token Token::clone() const
     (String,
         rv.m_data = Data::make_String(e);
         ),
+    (IString,
+        rv.m_data = Data::make_IString(e);
+        ),
     (Integer,
         rv.m_data = Data::make_Integer(e);
         ),
@@ -310,8 +323,8 @@ struct EscapedString {
     case TOK_INTERPOLATED_ITEM: return "/*:item*/";
     case TOK_INTERPOLATED_IDENT: return "/*:ident*/";
     // Value tokens
-    case TOK_IDENT:     return m_data.as_String();
-    case TOK_LIFETIME:  return "'" + m_data.as_String();
+    case TOK_IDENT:     return m_data.as_IString().str();
+    case TOK_LIFETIME:  return "'" + m_data.as_IString();
     case TOK_INTEGER:   return FMT(m_data.as_Integer().m_intval);    // TODO: suffix for type
     case TOK_CHAR:      return FMT("'\\u{"<< ::std::hex << m_data.as_Integer().m_intval << "}");
     case TOK_FLOAT:     return FMT(m_data.as_Float().m_floatval);
@@ -470,6 +483,9 @@ SERIALISE_TYPE(Token::, "Token", {
     (String,
         s << e;
         ),
+    (IString,
+        s << e.str();
+        ),
     (Integer,
         s % e.m_datatype;
         s.item( e.m_intval );
@@ -499,6 +515,11 @@ SERIALISE_TYPE(Token::, "Token", {
         s.item( str );
         m_data = Token::Data::make_String(str);
         break; }
+    case Token::Data::TAG_IString: {
+        ::std::string str;
+        s.item( str );
+        m_data = Token::Data::make_IString(RcString(str));
+        break; }
     case Token::Data::TAG_Integer: {
         enum eCoreType  dt;
         uint64_t    v;
@@ -527,7 +548,7 @@ SERIALISE_TYPE(Token::, "Token", {
     case TOK_BYTESTRING:
     case TOK_IDENT:
     case TOK_LIFETIME:
-        if( tok.m_data.is_String() )
+        if( tok.m_data.is_String() || tok.m_data.is_IString() )
             os << "\"" << EscapedString(tok.str()) << "\"";
         break;
     case TOK_INTEGER:
@@ -62,6 +62,7 @@ class Token:
     TAGGED_UNION(Data, None,
     (None, struct {}),
     (String, ::std::string),
+    (IString, RcString),
     (Integer, struct {
         enum eCoreType  m_datatype;
         uint64_t    m_intval;
@@ -99,6 +100,10 @@ public:
 
     Token(enum eTokenType type);
     Token(enum eTokenType type, ::std::string str);
+    Token(enum eTokenType type, RcString str);
+    Token(enum eTokenType type, const char* str):
+        Token(type, ::std::string(str))
+    {}
     Token(uint64_t val, enum eCoreType datatype);
     Token(double val, enum eCoreType datatype);
     Token(const InterpolatedFragment& );
@@ -106,8 +111,9 @@ public:
     Token(TagTakeIP, InterpolatedFragment );
 
     enum eTokenType type() const { return m_type; }
-    ::std::string& str() { return m_data.as_String(); }
-    const ::std::string& str() const { return m_data.as_String(); }
+    const ::std::string& str() const { return m_data.is_IString() ? m_data.as_IString().str() : m_data.as_String(); }
+    /// Interned string (identifiers and lifetimes)
+    const RcString& istr() const { return m_data.as_IString(); }
     enum eCoreType  datatype() const { TU_MATCH_DEF(Data, (m_data), (e), (assert(!"Getting datatype of invalid token type");), (Integer, return e.m_datatype;), (Float, return e.m_datatype;)) throw ""; }
     uint64_t intval() const { return m_data.as_Integer().m_intval; }
     double floatval() const { return m_data.as_Float().m_floatval; }
@@ -125,6 +131,7 @@ public:
         TU_MATCH(Data, (m_data, r.m_data), (e, re),
         (None, return true;),
         (String, return e == re; ),
+        (IString, return e == re; ),
         (Integer, return e.m_datatype == re.m_datatype && e.m_intval == re.m_intval;),
         (Float, return e.m_datatype == re.m_datatype && e.m_floatval == re.m_floatval;),
         (Fragment, assert(!"Token equality on Fragment");)
@@ -138,7 +138,7 @@ Span TokenStream::point_span() const
 Ident TokenStream::get_ident(Token tok) const
 {
     if(tok.type() == TOK_IDENT) {
-        return Ident(getHygiene(), tok.str());
+        return Ident(getHygiene(), tok.istr());
     }
     else if( tok.type() == TOK_INTERPOLATED_IDENT ) {
         TODO(getPosition(), "");
@@ -61,6 +61,8 @@ public:
     eTokenType  lookahead(unsigned int count);
 
     Ident::Hygiene getHygiene() const;
+    /// Returns true if there are tokens that have been read from the underlying source but not yet returned
+    bool has_buffered_tokens() const { return m_cache_valid || !m_lookahead.empty(); }
     virtual void push_hygine() {}
     virtual void pop_hygine() {}
 
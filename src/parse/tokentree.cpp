@@ -22,6 +22,71 @@ TokenTree TokenTree::clone() const
     }
 }
 
+FlatTokenTree::FlatTokenTree(TokenTree tt)
+{
+    this->push_tree(mv$(tt));
+
+    // Link each opening delimiter to the end of its group
+    // - Done on the token stream (instead of the tree structure) so it matches how the parser sees the tokens
+    ::std::vector<unsigned int> open_stack;
+    for(unsigned int i = 0; i < m_ents.size(); i ++)
+    {
+        switch(m_ents[i].tok.type())
+        {
+        case TOK_PAREN_OPEN:
+        case TOK_SQUARE_OPEN:
+        case TOK_BRACE_OPEN:
+            open_stack.push_back(i);
+            break;
+        case TOK_PAREN_CLOSE:
+        case TOK_SQUARE_CLOSE:
+        case TOK_BRACE_CLOSE:
+            if( !open_stack.empty() ) {
+                m_ents[open_stack.back()].tree_end = i+1;
+                open_stack.pop_back();
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
+void FlatTokenTree::push_tree(TokenTree tt)
+{
+    if( tt.is_token() )
+    {
+        unsigned int idx = m_ents.size();
+        m_ents.push_back(Ent { mv$(tt.m_hygiene), mv$(tt.m_tok), idx+1 });
+    }
+    else
+    {
+        for(auto& sub : tt.m_subtrees)
+            this->push_tree(mv$(sub));
+    }
+}
+FlatTokenTree::Slice FlatTokenTree::make_slice(TokenTree tt)
+{
+    auto tree = ::std::make_shared<FlatTokenTree>(mv$(tt));
+    unsigned int len = tree->size();
+    return Slice { mv$(tree), 0, len };
+}
+
+::std::ostream& operator<<(::std::ostream& os, const FlatTokenTree::Slice& x)
+{
+    if( !x.is_valid() )
+        return os;
+    for(unsigned int i = 0; i < x.size(); i ++)
+    {
+        if( i != 0 )
+            os << " ";
+        const auto& e = x[i];
+        if( e.tok.type() == TOK_IDENT || e.tok.type() == TOK_LIFETIME )
+            os << "/*" << e.hygiene << "*/";
+        os << e.tok.to_str();
+    }
+    return os;
+}
+
 ::std::ostream& operator<<(::std::ostream& os, const TokenTree& tt)
 {
     if( tt.m_subtrees.size() == 0 )
@@ -11,6 +11,7 @@
 #include "token.hpp"
 #include <ident.hpp>
 #include <vector>
+#include <memory>
 
 class TokenTree
 {
@@ -56,6 +57,50 @@ public:
     const Ident::Hygiene& hygiene() const { return m_hygiene; }
 
     friend ::std::ostream& operator<<(::std::ostream& os, const TokenTree& tt);
+    friend class FlatTokenTree;
+};
+
+/// Flattened token tree (used for macro invocation input and captured fragments)
+///
+/// All leaf tokens are stored in a single array in stream order (group delimiters included), with each entry
+/// recording the index just past the end of the group it opens. Sub-trees can then be skipped or referenced as
+/// a range of this array (see `Slice`) without walking or copying a tree.
+class FlatTokenTree
+{
+public:
+    struct Ent {
+        Ident::Hygiene  hygiene;
+        Token   tok;
+        /// Index one past the end of the tree starting here (`idx+1` for non-delimiter tokens)
+        unsigned int    tree_end;
+    };
+    /// Shared reference to a contiguous range of a flattened tree
+    struct Slice {
+        ::std::shared_ptr<FlatTokenTree>    tree;
+        unsigned int    first;
+        unsigned int    last;
+
+        bool is_valid() const { return tree.get() != nullptr; }
+        unsigned int size() const { return last - first; }
+        const Ent& operator[](unsigned int idx) const { assert(first + idx < last); return (*tree)[first + idx]; }
+    };
+private:
+    ::std::vector<Ent>  m_ents;
+
+    void push_tree(TokenTree tt);
+public:
+    FlatTokenTree() {}
+    FlatTokenTree(TokenTree tt);
+    FlatTokenTree(const FlatTokenTree&) = delete;
+
+    /// Flatten a token tree into a new (shared) arena, and return a slice covering all of it
+    static Slice make_slice(TokenTree tt);
+
+    unsigned int size() const { return m_ents.size(); }
+    const Ent& operator[](unsigned int idx) const { assert(idx < m_ents.size()); return m_ents[idx]; }
+          Ent& operator[](unsigned int idx)       { assert(idx < m_ents.size()); return m_ents[idx]; }
+
+    friend ::std::ostream& operator<<(::std::ostream& os, const FlatTokenTree::Slice& x);
 };
 
 #endif // TOKENTREE_HPP_INCLUDED
@@ -119,3 +119,58 @@ Ident::Hygiene TTStreamO::realGetHygiene() const
         return Ident::Hygiene();
     return *m_hygiene_ptr;
 }
+
+
+TTStreamFlat::TTStreamFlat(Span parent, FlatTokenTree::Slice slice, bool can_steal):
+    m_slice( mv$(slice) ),
+    m_pos( 0 ),
+    m_can_steal( can_steal ),
+    m_parent_span( new Span(mv$(parent)) )
+{
+}
+TTStreamFlat::~TTStreamFlat()
+{
+}
+FlatTokenTree::Slice TTStreamFlat::take_tt()
+{
+    if( this->has_buffered_tokens() || m_pos == m_slice.size() )
+        return FlatTokenTree::Slice {};
+    auto& tree = *m_slice.tree;
+    unsigned int first = m_slice.first + m_pos;
+    unsigned int last = tree[first].tree_end;
+    switch( tree[first].tok.type() )
+    {
+    case TOK_PAREN_CLOSE:
+    case TOK_SQUARE_CLOSE:
+    case TOK_BRACE_CLOSE:
+        return FlatTokenTree::Slice {};
+    default:
+        break;
+    }
+    assert(last <= m_slice.last);
+    m_pos = last - m_slice.first;
+    m_last_pos = tree[last-1].tok.get_pos();
+    m_last_hygiene = tree[last-1].hygiene;
+    return FlatTokenTree::Slice { m_slice.tree, first, last };
+}
+Token TTStreamFlat::realGetToken()
+{
+    if( m_pos == m_slice.size() )
+        return Token(TOK_EOF);
+    auto& ent = (*m_slice.tree)[m_slice.first + m_pos];
+    m_pos ++;
+    m_last_pos = ent.tok.get_pos();
+    m_last_hygiene = ent.hygiene;
+    if( m_can_steal )
+        return mv$(ent.tok);
+    else
+        return ent.tok.clone();
+}
+Position TTStreamFlat::getPosition() const
+{
+    return m_last_pos;
+}
+Ident::Hygiene TTStreamFlat::realGetHygiene() const
+{
+    return m_last_hygiene;
+}
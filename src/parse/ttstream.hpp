@@ -55,3 +55,31 @@ protected:
     Ident::Hygiene realGetHygiene() const override;
     Token realGetToken() override;
 };
+
+/// TTStream over a range of a flattened token tree
+///
+/// Tokens are cloned out of the (shared) arena, unless the stream was told it has exclusive use of the range.
+class TTStreamFlat:
+    public TokenStream
+{
+    Position    m_last_pos;
+    FlatTokenTree::Slice    m_slice;
+    unsigned int    m_pos;
+    bool    m_can_steal;
+    Ident::Hygiene  m_last_hygiene;
+public:
+    ::std::shared_ptr<Span> m_parent_span;
+    TTStreamFlat(Span parent, FlatTokenTree::Slice slice, bool can_steal=false);
+    ~TTStreamFlat();
+
+    /// Take the next token tree as a slice of the underlying arena (without copying tokens)
+    /// - Only valid when there are no tokens pending in the base TokenStream, returns an invalid slice otherwise.
+    FlatTokenTree::Slice take_tt();
+
+    Position getPosition() const override;
+    ::std::shared_ptr<Span> outerSpan() const override { return m_parent_span; }
+
+protected:
+    Ident::Hygiene realGetHygiene() const override;
+    Token realGetToken() override;
+};
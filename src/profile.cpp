@@ -0,0 +1,160 @@
+/*
+ * MRustC - Rust Compiler
+ * - By John Hodge (Mutabah/thePowersGang)
+ *
+ * profile.cpp
+ * - Per-item compile time profiling (`--profile <file>`)
+ */
+#include <profile.hpp>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+bool g_profile_enabled = false;
+
+namespace {
+    struct Event
+    {
+        const char* category;
+        ::std::string   name;
+        unsigned int    thread;
+        unsigned long long  start_us;
+        unsigned long long  duration_us;
+        unsigned int    count;
+    };
+
+    ::std::mutex    s_events_lock;
+    ::std::vector<Event>    s_events;
+
+    const auto  s_start_time = ::std::chrono::steady_clock::now();
+    ::std::atomic<unsigned int> s_next_thread_index { 0 };
+    thread_local unsigned int   s_thread_index = ~0u;
+    thread_local ProfileScope*  s_innermost = nullptr;
+
+    unsigned long long now_us()
+    {
+        return ::std::chrono::duration_cast< ::std::chrono::microseconds>( ::std::chrono::steady_clock::now() - s_start_time ).count();
+    }
+    unsigned int thread_index()
+    {
+        if( s_thread_index == ~0u )
+            s_thread_index = s_next_thread_index ++;
+        return s_thread_index;
+    }
+
+    void write_json_string(::std::ostream& os, const ::std::string& s)
+    {
+        os << '"';
+        for(char c : s)
+        {
+            switch(c)
+            {
+            case '"':   os << "\\\"";   break;
+            case '\\':  os << "\\\\";   break;
+            case '\n':  os << "\\n";    break;
+            default:
+                if( static_cast<unsigned char>(c) < 0x20 )
+                    os << "\\u" << ::std::hex << ::std::setw(4) << ::std::setfill('0') << static_cast<unsigned>(c) << ::std::dec << ::std::setfill(' ');
+                else
+                    os << c;
+                break;
+            }
+        }
+        os << '"';
+    }
+}
+
+void ProfileScope::start(const char* category, ::std::string name)
+{
+    m_category = category;
+    m_name = ::std::move(name);
+    m_count = 0;
+    m_parent = s_innermost;
+    s_innermost = this;
+    m_start_us = now_us();
+}
+ProfileScope::~ProfileScope()
+{
+    if( !m_category )
+        return ;
+    auto end_us = now_us();
+    s_innermost = m_parent;
+
+    ::std::lock_guard< ::std::mutex>    lh { s_events_lock };
+    s_events.push_back(Event { m_category, ::std::move(m_name), thread_index(), m_start_us, end_us - m_start_us, m_count });
+}
+void ProfileScope::add_count(unsigned int count)
+{
+    if( s_innermost )
+        s_innermost->m_count += count;
+}
+
+void Profile_Write(const ::std::string& trace_filename, unsigned int top_n)
+{
+    ::std::lock_guard< ::std::mutex>    lh { s_events_lock };
+
+    {
+        ::std::ofstream os(trace_filename);
+        if( !os.good() )
+        {
+            ::std::cerr << "Unable to open " << trace_filename << " for writing" << ::std::endl;
+            return ;
+        }
+        os << "{\"traceEvents\":[\n";
+        for(const auto& ev : s_events)
+        {
+            if( &ev != &s_events.front() )
+                os << ",\n";
+            os << "{\"name\":"; write_json_string(os, ev.name);
+            os << ",\"cat\":\"" << ev.category << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << ev.thread;
+            os << ",\"ts\":" << ev.start_us << ",\"dur\":" << ev.duration_us;
+            if( ev.count > 0 )
+                os << ",\"args\":{\"count\":" << ev.count << "}";
+            os << "}";
+        }
+        os << "\n]}\n";
+    }
+
+    // Summarise by item (an item can be visited more than once, e.g. a macro invoked several times)
+    struct Total {
+        unsigned long long  duration_us = 0;
+        unsigned int    calls = 0;
+        unsigned int    count = 0;
+    };
+    ::std::map< ::std::string, ::std::map< ::std::string, Total> >  totals;
+    for(const auto& ev : s_events)
+    {
+        auto& t = totals[ev.category][ev.name];
+        t.duration_us += ev.duration_us;
+        t.calls += 1;
+        t.count += ev.count;
+    }
+
+    for(const auto& cat : totals)
+    {
+        ::std::vector< ::std::pair<const ::std::string*, const Total*> >   sorted;
+        for(const auto& e : cat.second)
+            sorted.push_back(::std::make_pair(&e.first, &e.second));
+        ::std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b){ return a.second->duration_us > b.second->duration_us; });
+        if( sorted.size() > top_n )
+            sorted.resize(top_n);
+
+        ::std::cout << "Profile: " << cat.first << " (top " << sorted.size() << " of " << cat.second.size() << ")" << ::std::endl;
+        for(const auto& e : sorted)
+        {
+            ::std::cout << ::std::setw(10) << ::std::fixed << ::std::setprecision(3) << (e.second->duration_us / 1000.0) << " ms  ";
+            ::std::cout << *e.first;
+            if( e.second->calls > 1 )
+                ::std::cout << " (x" << e.second->calls << ")";
+            if( e.second->count > 0 )
+                ::std::cout << " [count " << e.second->count << "]";
+            ::std::cout << ::std::endl;
+        }
+    }
+}
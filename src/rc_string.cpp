@@ -1,44 +1,91 @@
 /*
+ * MRustC - Rust Compiler
+ * - By John Hodge (Mutabah/thePowersGang)
+ *
+ * rc_string.cpp
+ * - Interned string table
  */
 #include <rc_string.hpp>
-#include <cstring>
-#include <iostream>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <vector>
 
-RcString::RcString(const char* s, unsigned int len):
-    m_ptr(nullptr),
-    m_len(len)
-{
-    if( len > 0 )
+namespace {
+    /// Lookup key, points at the text of the symbol (stable, as symbols are never freed or moved) or the string being interned
+    struct StrKey
+    {
+        const char* ptr;
+        size_t  len;
+
+        bool operator==(const StrKey& x) const {
+            return len == x.len && ::std::memcmp(ptr, x.ptr, len) == 0;
+        }
+    };
+    struct StrKeyHash
     {
-        m_ptr = new unsigned int[1 + (len+1 + sizeof(unsigned int)-1) / sizeof(unsigned int)];
-        *m_ptr = 1;
-        char* data_mut = reinterpret_cast<char*>(m_ptr + 1);
-        for(unsigned int j = 0; j < len; j ++ )
-            data_mut[j] = s[j];
-        data_mut[len] = '\0';
+        size_t operator()(const StrKey& k) const {
+            // FNV-1a
+            size_t  h = static_cast<size_t>(0xcbf29ce484222325ull);
+            for(size_t i = 0; i < k.len; i ++)
+            {
+                h ^= static_cast<unsigned char>(k.ptr[i]);
+                h *= static_cast<size_t>(0x100000001b3ull);
+            }
+            return h;
+        }
+    };
+
+    struct SymbolTable
+    {
+        ::std::mutex    lock;
+        ::std::unordered_map<StrKey, const RcString::Symbol*, StrKeyHash>   lookup;
+        ::std::vector< ::std::unique_ptr<RcString::Symbol> >    symbols;
+
+        SymbolTable()
+        {
+            // Reserve id 0 for the empty string (which is represented as a null pointer)
+            symbols.push_back(nullptr);
+        }
+    };
+    SymbolTable& get_table() {
+        static SymbolTable  s_table;
+        return s_table;
     }
 }
-RcString::~RcString()
+
+const ::std::string RcString::s_empty_str;
+
+RcString::RcString(const char* s, unsigned int len):
+    m_ptr(nullptr)
 {
-    if(m_ptr)
+    if( len > 0 )
     {
-        *m_ptr -= 1;
-        //::std::cout << "RcString(\"" << *this << "\") - " << *m_ptr << " refs left" << ::std::endl;
-        if( *m_ptr == 0 )
+        auto& tbl = get_table();
+        ::std::lock_guard< ::std::mutex>    lh(tbl.lock);
+        auto it = tbl.lookup.find(StrKey { s, len });
+        if( it != tbl.lookup.end() )
+        {
+            m_ptr = it->second;
+        }
+        else
         {
-            delete[] m_ptr;
-            m_ptr = nullptr;
+            auto* sym = new Symbol { static_cast<unsigned int>(tbl.symbols.size()), ::std::string(s, len) };
+            tbl.symbols.push_back( ::std::unique_ptr<Symbol>(sym) );
+            tbl.lookup.insert( ::std::make_pair(StrKey { sym->text.data(), sym->text.size() }, sym) );
+            m_ptr = sym;
         }
     }
 }
+unsigned int RcString::symbol_count()
+{
+    auto& tbl = get_table();
+    ::std::lock_guard< ::std::mutex>    lh(tbl.lock);
+    return tbl.symbols.size() - 1;
+}
 bool RcString::operator==(const char* s) const
 {
-    if( m_len == 0 )
+    if( !m_ptr )
         return *s == '\0';
-    auto m = this->c_str();
-    do {
-        if( *m != *s )
-            return false;
-    } while( *m++ != '\0' && *s++ != '\0' );
-    return true;
+    return ::std::strcmp(m_ptr->text.c_str(), s) == 0;
 }
@@ -11,14 +11,17 @@
 #include <mir/mir.hpp>
 #include <mir/operations.hpp>
 #include <algorithm>
+#include <profile.hpp>
 
 #include "codegen.hpp"
 #include "monomorphise.hpp"
+#include "mangling.hpp"
 
 void Trans_Codegen(const ::std::string& outfile, const TransOptions& opt, const ::HIR::Crate& crate, const TransList& list, bool is_executable)
 {
     static Span sp;
-    auto codegen = Trans_Codegen_GetGeneratorC(crate, outfile);
+    g_mangle_compact = opt.compact_mangling;
+    auto codegen = Trans_Codegen_GetGeneratorC(crate, outfile, opt);
 
     // 1. Emit structure/type definitions.
     // - Emit in the order they're needed.
@@ -87,7 +90,7 @@ void Trans_Codegen(const ::std::string& outfile, const TransOptions& opt, const
         DEBUG("FUNCTION " << ent.first);
         assert( ent.second->ptr );
         const auto& fcn = *ent.second->ptr;
-        bool is_extern = ! static_cast<bool>(fcn.m_code);
+        bool is_extern = ! fcn.m_code.is_local();
         if( fcn.m_code.m_mir ) {
             codegen->emit_function_proto(ent.first, fcn, ent.second->pp, is_extern);
         }
@@ -148,31 +151,20 @@ void Trans_Codegen(const ::std::string& outfile, const TransOptions& opt, const
             const auto& fcn = *ent.second->ptr;
             const auto& pp = ent.second->pp;
             TRACE_FUNCTION_F(path);
+            PROFILE_ITEM("codegen", path);
             DEBUG("FUNCTION CODE " << path);
-            bool is_extern = ! static_cast<bool>(fcn.m_code);
-            // If this is a provided trait method, it needs to be monomorphised too.
-            bool is_method = ( fcn.m_args.size() > 0 && visit_ty_with(fcn.m_args[0].second, [&](const auto& x){return x == ::HIR::TypeRef("Self",0xFFFF);}) );
-            if( pp.has_types() || is_method )
+            bool is_extern = ! fcn.m_code.is_local();
+            // Generic instances (and provided trait methods) were monomorphised and optimised during enumeration
+            if( ent.second->monomorphised )
             {
-                ::StaticTraitResolve    resolve { crate };
-                auto ret_type = pp.monomorph(resolve, fcn.m_return);
-                ::HIR::Function::args_t args;
-                for(const auto& a : fcn.m_args)
-                    args.push_back(::std::make_pair( ::HIR::Pattern{}, pp.monomorph(resolve, a.second) ));
-                auto mir = Trans_Monomorphise(resolve, pp, fcn.m_code.m_mir);
-                ::std::string s = FMT(path);
-                ::HIR::ItemPath ip(s);
-                MIR_Validate(resolve, ip, *mir, args, ret_type);
-                MIR_Cleanup(resolve, ip, *mir, args, ret_type);
-                MIR_Optimise(resolve, ip, *mir, args, ret_type);
-                MIR_Validate(resolve, ip, *mir, args, ret_type);
                 // TODO: Flag that this should be a weak (or weak-er) symbol?
                 // - If it's from an external crate, it should be weak
-                codegen->emit_function_code(path, fcn, ent.second->pp, is_extern,  mir);
+                codegen->emit_function_code(path, fcn, ent.second->pp, is_extern,  ent.second->monomorphised);
             }
             // TODO: Detect if the function was a #[inline] function from another crate, and don't emit if that is the case?
             // - Emiting is nice, but it should be emitted as a weak symbol
             else {
+                ASSERT_BUG(sp, !Trans_Monomorphise_Needed(fcn, pp), "Function " << path << " wasn't monomorphised during enumeration");
                 codegen->emit_function_code(path, fcn, pp, is_extern,  fcn.m_code.m_mir);
             }
         }
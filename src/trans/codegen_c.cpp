@@ -10,6 +10,9 @@
 #include <fstream>
 #include <algorithm>
 #include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
 #include <hir/hir.hpp>
 #include <mir/mir.hpp>
 #include <hir_typeck/static.hpp>
@@ -122,6 +125,8 @@ namespace {
 
         ::std::string   m_outfile_path;
         ::std::string   m_outfile_path_c;
+        /// Shared prelude header included by the output (empty if the prelude is emitted in-line)
+        ::std::string   m_prelude_path;
 
         ::std::ofstream m_of;
         const ::MIR::TypeResolve* m_mir_res;
@@ -130,24 +135,41 @@ namespace {
         struct {
             bool emulated_i128 = false;
             bool disallow_empty_structs = false;
+            bool structured = true;
+            bool fold_identical = false;
         } m_options;
 
         ::std::map<::HIR::GenericPath, ::std::vector<unsigned>> m_enum_repr_cache;
 
         ::std::vector< ::std::pair< ::HIR::GenericPath, const ::HIR::Struct*> >   m_box_glue_todo;
+
+        /// Identical code folding: an item emitted in full, and the location of its text in the output file
+        struct FoldTarget {
+            ::std::string   name;
+            ::std::streampos    offset;
+            size_t  len;
+        };
+        /// Identical code folding: items emitted in full, keyed on the hash of their canonical text (see `get_fold_text`)
+        /// - Only the hash is kept in memory, on a hash hit the target's text is read back from the output and compared.
+        ::std::unordered_map< size_t, ::std::vector<FoldTarget> >   m_fold_targets;
+        /// Identical code folding: items emitted as an alias, and the item they alias
+        ::std::unordered_map< ::std::string, ::std::string>    m_fold_aliases;
     public:
-        CodeGenerator_C(const ::HIR::Crate& crate, const ::std::string& outfile):
+        CodeGenerator_C(const ::HIR::Crate& crate, const ::std::string& outfile, const TransOptions& opt):
             m_crate(crate),
             m_resolve(crate),
             m_outfile_path(outfile),
             m_outfile_path_c(outfile + ".c"),
             m_of(m_outfile_path_c)
         {
+            m_options.structured = opt.structured_c;
             switch(Target_GetCurSpec().m_codegen_mode)
             {
             case CodegenMode::Gnu11:
                 m_compiler = Compiler::Gcc;
                 m_options.emulated_i128 = false;
+                // Folding uses `__attribute__((alias))`, which Mach-O doesn't support
+                m_options.fold_identical = opt.fold_identical && Target_GetCurSpec().m_os_name != "macos";
                 break;
             case CodegenMode::Msvc:
                 m_compiler = Compiler::Msvc;
@@ -160,6 +182,33 @@ namespace {
                 << "/*\n"
                 << " * AUTOGENERATED by mrustc\n"
                 << " */\n"
+                ;
+            if( m_compiler == Compiler::Gcc && opt.shared_c_prelude )
+            {
+                ::std::stringstream prelude;
+                prelude
+                    << "/*\n"
+                    << " * AUTOGENERATED by mrustc - Common prelude, shared between crates\n"
+                    // Compiler options are included so a precompiled header is only shared between compatible builds
+                    << " * Options: -O" << opt.opt_level << (opt.emit_debug_info ? " -g" : "") << "\n"
+                    << " */\n"
+                    ;
+                this->emit_prelude(prelude);
+                m_prelude_path = this->write_shared_prelude(prelude.str());
+                // NOTE: This must be the first thing in the file for GCC to use the precompiled header
+                auto slash = m_prelude_path.find_last_of("/\\");
+                m_of << "#include \"" << (slash == ::std::string::npos ? m_prelude_path : m_prelude_path.substr(slash+1)) << "\"\n";
+            }
+            else
+            {
+                this->emit_prelude(m_of);
+            }
+        }
+
+        /// Common typedefs and helpers used by generated code (independent of the crate being compiled)
+        void emit_prelude(::std::ostream& os)
+        {
+            os
                 << "#include <stddef.h>\n"
                 << "#include <stdint.h>\n"
                 << "#include <stdbool.h>\n"
@@ -170,17 +219,17 @@ namespace {
             switch(m_compiler)
             {
             case Compiler::Gcc:
-                m_of
+                os
                     << "#include <stdatomic.h>\n"   // atomic_*
                     ;
                 break;
             case Compiler::Msvc:
-                m_of
+                os
                     << "#include <Windows.h>\n" // Interlocked*
                     ;
                 break;
             }
-            m_of
+            os
                 << "typedef uint32_t RUST_CHAR;\n"
                 << "typedef struct { void* PTR; size_t META; } SLICE_PTR;\n"
                 << "typedef struct { void* PTR; void* META; } TRAITOBJ_PTR;\n"
@@ -188,7 +237,7 @@ namespace {
                 ;
             if( m_options.disallow_empty_structs )
             {
-                m_of
+                os
                     << "typedef struct { char _d; } tUNIT;\n"
                     << "typedef struct { char _d; } tBANG;\n"
                     << "typedef struct { char _d; } tTYPEID;\n"
@@ -196,19 +245,19 @@ namespace {
             }
             else
             {
-                m_of
+                os
                     << "typedef struct { } tUNIT;\n"
                     << "typedef struct { } tBANG;\n"
                     << "typedef struct { } tTYPEID;\n"
                     ;
             }
-            m_of
+            os
                 << "\n"
                 ;
             switch(m_compiler)
             {
             case Compiler::Gcc:
-                m_of
+                os
                     << "typedef unsigned __int128 uint128_t;\n"
                     << "typedef signed __int128 int128_t;\n"
                     << "extern void _Unwind_Resume(void) __attribute__((noreturn));\n"
@@ -216,7 +265,7 @@ namespace {
                     ;
                 break;
             case Compiler::Msvc:
-                m_of
+                os
                     << "__declspec(noreturn) extern void _Unwind_Resume(void);\n"
                     << "#define ALIGNOF(t) __alignof(t)\n"
                     ;
@@ -228,7 +277,7 @@ namespace {
             {
             case Compiler::Gcc:
                 // 64-bit bit ops (gcc intrinsics)
-                m_of
+                os
                     << "static inline uint64_t __builtin_clz64(uint64_t v) {\n"
                     << "\treturn (v >> 32 != 0 ? __builtin_clz(v>>32) : 32 + __builtin_clz(v));\n"
                     << "}\n"
@@ -242,7 +291,7 @@ namespace {
 
             if( m_options.emulated_i128 )
             {
-                m_of
+                os
                     << "typedef struct { uint64_t lo, hi; } uint128_t;\n"
                     << "typedef struct { uint64_t lo, hi; } int128_t;\n"
                     << "static inline int128_t make128s(int64_t v) { int128_t rv = { v, (v < 0 ? -1 : 0) }; return rv; }\n"
@@ -282,7 +331,7 @@ namespace {
             else
             {
                 // GCC-only
-                m_of
+                os
                     << "static inline uint128_t __builtin_bswap128(uint128_t v) {\n"
                     << "\tuint64_t lo = __builtin_bswap64((uint64_t)v);\n"
                     << "\tuint64_t hi = __builtin_bswap64((uint64_t)(v>>64));\n"
@@ -298,7 +347,7 @@ namespace {
             }
 
             // Common helpers
-            m_of
+            os
                 << "\n"
                 << "static inline int slice_cmp(SLICE_PTR l, SLICE_PTR r) {\n"
                 << "\tint rv = memcmp(l.PTR, r.PTR, l.META < r.META ? l.META : r.META);\n"
@@ -315,6 +364,149 @@ namespace {
                 << "\n"
                 ;
         }
+        /// Write the prelude beside the output, named by a hash of its contents so it's shared between crates
+        ::std::string write_shared_prelude(const ::std::string& contents)
+        {
+            // FNV-1a
+            uint64_t    hash = 0xcbf29ce484222325;
+            for(unsigned char c : contents)
+            {
+                hash ^= c;
+                hash *= 0x100000001b3;
+            }
+            auto slash = m_outfile_path_c.find_last_of("/\\");
+            auto dir = (slash == ::std::string::npos ? ::std::string() : m_outfile_path_c.substr(0, slash+1));
+            auto path = FMT(dir << "mrustc_prelude-" << ::std::hex << ::std::setw(16) << ::std::setfill('0') << hash << ".h");
+
+            if( !::std::ifstream(path).good() )
+            {
+                // Written to a temporary then renamed, in case another crate is being built at the same time
+                auto tmp_path = m_outfile_path_c + ".prelude.tmp";
+                {
+                    ::std::ofstream of(tmp_path);
+                    of << contents;
+                }
+                ::std::rename(tmp_path.c_str(), path.c_str());
+            }
+            return path;
+        }
+        /// Build a GCC precompiled header for the shared prelude (if not already present)
+        /// - If this fails, the prelude is just parsed as normal
+        void build_prelude_pch(const TransOptions& opt)
+        {
+            auto gch_path = m_prelude_path + ".gch";
+            if( ::std::ifstream(gch_path).good() )
+                return ;
+            auto tmp_path = m_outfile_path_c + ".gch.tmp";
+
+            ::std::stringstream cmd_ss;
+            cmd_ss << "\"" << FmtShell(getenv("CC") ? getenv("CC") : "gcc", false) << "\" -x c-header -ffunction-sections -pthread";
+            if( opt.opt_level > 0 )
+                cmd_ss << " -O" << opt.opt_level;
+            if( opt.emit_debug_info )
+                cmd_ss << " -g";
+            cmd_ss << " -o \"" << FmtShell(tmp_path, false) << "\" \"" << FmtShell(m_prelude_path, false) << "\"";
+            ::std::cout << "Running command - " << cmd_ss.str() << ::std::endl;
+            if( system(cmd_ss.str().c_str()) != 0 )
+            {
+                ::std::cerr << "Warning: Precompiling " << m_prelude_path << " failed" << ::std::endl;
+                ::std::remove(tmp_path.c_str());
+                return ;
+            }
+            ::std::rename(tmp_path.c_str(), gch_path.c_str());
+        }
+
+        /// Run `cb` with its output captured instead of written to the output file
+        template<typename Fcn>
+        ::std::string emit_to_string(Fcn cb)
+        {
+            ::std::stringstream ss;
+            auto* old_buf = static_cast< ::std::ostream&>(m_of).rdbuf(ss.rdbuf());
+            cb();
+            static_cast< ::std::ostream&>(m_of).rdbuf(old_buf);
+            return ss.str();
+        }
+        /// Canonical form of an emitted item for identical code folding
+        /// - Comments (which name the item and its types) are skipped, the item's own name is replaced with a placeholder,
+        ///   and references to already-folded items are replaced by the item they alias (so folding can cascade).
+        ::std::string get_fold_text(const ::std::string& text, const ::std::string& self_name) const
+        {
+            ::std::string   key;
+            key.reserve(text.size());
+            auto is_ident = [](char c) { return isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$'; };
+            for(size_t i = 0; i < text.size(); )
+            {
+                char c = text[i];
+                if( c == '/' && i+1 < text.size() && text[i+1] == '/' ) {
+                    while( i < text.size() && text[i] != '\n' )
+                        i ++;
+                }
+                else if( c == '/' && i+1 < text.size() && text[i+1] == '*' ) {
+                    auto end = text.find("*/", i+2);
+                    i = (end == ::std::string::npos ? text.size() : end + 2);
+                }
+                else if( c == '"' || c == '\'' ) {
+                    key += c;
+                    i ++;
+                    while( i < text.size() && text[i] != c ) {
+                        if( text[i] == '\\' && i+1 < text.size() )
+                            key += text[i++];
+                        key += text[i++];
+                    }
+                    if( i < text.size() )
+                        key += text[i++];
+                }
+                else if( is_ident(c) ) {
+                    size_t start = i;
+                    while( i < text.size() && is_ident(text[i]) )
+                        i ++;
+                    auto tok = text.substr(start, i - start);
+                    auto it = m_fold_aliases.find(tok);
+                    if( tok == self_name )
+                        key += "$@";
+                    else if( it != m_fold_aliases.end() )
+                        key += it->second;
+                    else
+                        key += tok;
+                }
+                else {
+                    key += c;
+                    i ++;
+                }
+            }
+            return key;
+        }
+        /// Write an item's emitted text, or (if an identical item has already been emitted) just its declaration as an alias
+        /// - `decl_end` is the end of the declaration part of `text` (`~0` if it can't be folded)
+        void emit_folded(const ::std::string& text, const ::std::string& name, size_t decl_end)
+        {
+            auto key = get_fold_text(text, name);
+            auto& targets = m_fold_targets[ ::std::hash< ::std::string>()(key) ];
+            if( decl_end != ::std::string::npos )
+            {
+                for(const auto& t : targets)
+                {
+                    if( get_fold_text(this->read_emitted(t.offset, t.len), t.name) != key )
+                        continue ;
+                    DEBUG("Folding " << name << " into " << t.name);
+                    m_fold_aliases.insert(::std::make_pair(name, t.name));
+                    m_of << text.substr(0, decl_end) << " __attribute__((alias(\"" << t.name << "\")));\n";
+                    return ;
+                }
+            }
+            targets.push_back(FoldTarget { name, m_of.tellp(), text.size() });
+            m_of << text;
+        }
+        /// Read back a block of text already written to the output file
+        ::std::string read_emitted(::std::streampos offset, size_t len)
+        {
+            m_of.flush();
+            ::std::ifstream is(m_outfile_path_c);
+            is.seekg(offset);
+            ::std::string   rv(len, '\0');
+            is.read(&rv[0], len);
+            return rv;
+        }
 
         ~CodeGenerator_C() {}
 
@@ -460,6 +652,10 @@ namespace {
             auto cache_str = [&](::std::string s){ tmp.push_back(::std::move(s)); return tmp.back().c_str(); };
             ::std::vector<const char*>  args;
             bool is_windows = false;
+            if( m_prelude_path != "" )
+            {
+                this->build_prelude_pch(opt);
+            }
             switch( m_compiler )
             {
             case Compiler::Gcc:
@@ -1606,6 +1802,64 @@ namespace {
                 m_of << "{ ";
                 this->print_escaped_string(e);
                 m_of << ", " << e.size() << "}";
+                ),
+            (Repeat,
+                MIR_ASSERT(*m_mir_res, ty.m_data.is_Array(), "Repeat literal for non-array type - " << ty);
+                const auto& ity = *ty.m_data.as_Array().inner;
+                if( is_zero_literal(*e.val) )
+                {
+                    // Zero-filled, let the C compiler fill the rest
+                    m_of << "{{0}}";
+                }
+                else if( m_compiler == Compiler::Gcc )
+                {
+                    m_of << "{{ [0 ... " << e.count - 1 << "] = ";
+                    emit_literal(ity, *e.val, params);
+                    m_of << " }}";
+                }
+                else
+                {
+                    m_of << "{{";
+                    for(uint64_t i = 0; i < e.count; i ++) {
+                        if(i != 0)  m_of << ",";
+                        m_of << " ";
+                        emit_literal(ity, *e.val, params);
+                    }
+                    m_of << " }}";
+                }
+                ),
+            (Bytes,
+                MIR_ASSERT(*m_mir_res, ty.m_data.is_Array(), "Bytes literal for non-array type - " << ty);
+                // NOTE: C allows a string literal to exactly fill a char array (dropping the NUL)
+                m_of << "{ ";
+                this->print_escaped_string(::std::string(e.begin(), e.end()));
+                m_of << " }";
+                )
+            )
+        }
+        static bool is_zero_literal(const ::HIR::Literal& lit)
+        {
+            TU_MATCH_DEF( ::HIR::Literal, (lit), (e),
+            (
+                return false;
+                ),
+            (List,
+                for(const auto& v : e)
+                    if( !is_zero_literal(v) )
+                        return false;
+                return true;
+                ),
+            (Integer,
+                return e == 0;
+                ),
+            (Float,
+                return e == 0 && !::std::signbit(e);
+                ),
+            (Repeat,
+                return is_zero_literal(*e.val);
+                ),
+            (Bytes,
+                return ::std::all_of(e.begin(), e.end(), [](uint8_t b){ return b == 0; });
                 )
             )
         }
@@ -1660,6 +1914,8 @@ namespace {
 
         void emit_vtable(const ::HIR::Path& p, const ::HIR::Trait& trait) override
         {
+            // NOTE: Vtables aren't folded, their sizes are emitted as `sizeof(T)` and their type is specific to the trait
+            // instance, so they're only identical for the same (type, trait) pair (which is only emitted once).
             ::MIR::TypeResolve  top_mir_res { sp, m_resolve, FMT_CB(ss, ss << "vtable " << p;), ::HIR::TypeRef(), {}, *(::MIR::Function*)nullptr };
             m_mir_res = &top_mir_res;
 
@@ -1814,6 +2070,18 @@ namespace {
             m_mir_res = nullptr;
         }
         void emit_function_code(const ::HIR::Path& p, const ::HIR::Function& item, const Trans_Params& params, bool is_extern_def, const ::MIR::FunctionPointer& code) override
+        {
+            // NOTE: Functions with a linkage name are `#define`d to that name, so can't be an alias target (or alias)
+            if( !m_options.fold_identical || item.m_linkage.name != "" )
+            {
+                this->emit_function_code_inner(p, item, params, is_extern_def, code);
+                return ;
+            }
+            auto text = this->emit_to_string([&]{ this->emit_function_code_inner(p, item, params, is_extern_def, code); });
+            this->emit_folded(text, FMT(Trans_Mangle(p)), text.find("\n{\n"));
+            m_of.flush();
+        }
+        void emit_function_code_inner(const ::HIR::Path& p, const ::HIR::Function& item, const Trans_Params& params, bool is_extern_def, const ::MIR::FunctionPointer& code)
         {
             TRACE_FUNCTION_F(p);
 
@@ -1842,8 +2110,24 @@ namespace {
                 m_of << "\t// " << code->locals[i];
                 m_of << "\n";
             }
-            for(unsigned int i = 0; i < code->drop_flags.size(); i ++) {
-                m_of << "\tbool df" << i << " = " << code->drop_flags[i] << ";\n";
+            // Drop flags are packed into 64-bit words, flag N is bit `N % 64` of `dfw{N / 64}`
+            for(unsigned int w = 0; w * 64 < code->drop_flags.size(); w ++) {
+                uint64_t    init = 0;
+                for(unsigned int i = w * 64; i < code->drop_flags.size() && i < (w + 1) * 64; i ++)
+                    if( code->drop_flags[i] )
+                        init |= uint64_t(1) << (i % 64);
+                m_of << "\tuint64_t dfw" << w << " = 0x" << ::std::hex << init << ::std::dec << "ull;\n";
+            }
+
+            if( m_options.structured )
+            {
+                ::std::vector<bool> labelled;
+                auto root = NodeRef( MIR_To_Structured(*code, labelled) );
+                this->emit_fcn_node(mir_res, root, labelled, 1);
+                m_of << "}\n";
+                m_of.flush();
+                m_mir_res = nullptr;
+                return ;
             }
 
             ::std::vector<unsigned> bb_use_counts( code->blocks.size() );
@@ -1871,7 +2155,9 @@ namespace {
                         bb_use_counts[t] ++;
                     ),
                 (SwitchValue,
-                    MIR_TODO(mir_res, "SwitchValue in C codegen");
+                    for(const auto& t : te.targets)
+                        bb_use_counts[t] ++;
+                    bb_use_counts[te.def_target] ++;
                     ),
                 (Call,
                     bb_use_counts[te.ret_block] ++;
@@ -1879,17 +2165,6 @@ namespace {
                 )
             }
 
-            if( false )
-            {
-                m_of << "#if 0\n";
-                auto nodes = MIR_To_Structured(*code);
-                for(const auto& node : nodes)
-                {
-                    emit_fcn_node(mir_res, node, 1);
-                }
-                m_of << "#endif\n";
-            }
-
             for(unsigned int i = 0; i < code->blocks.size(); i ++)
             {
                 TRACE_FUNCTION_F(p << " bb" << i);
@@ -2005,7 +2280,9 @@ namespace {
                     }
                     ),
                 (SwitchValue,
-                    MIR_TODO(mir_res, "SwitchValue in C codegen");
+                    this->emit_term_switchvalue(mir_res, e.val, e.values, 1, [&](size_t idx) {
+                        m_of << "goto bb" << (idx == SIZE_MAX ? e.def_target : e.targets.at(idx)) << ";";
+                        });
                     ),
                 (Call,
                     emit_term_call(mir_res, e, 1);
@@ -2026,100 +2303,110 @@ namespace {
             m_mir_res = nullptr;
         }
 
-        void emit_fcn_node(::MIR::TypeResolve& mir_res, const Node& node, unsigned indent_level)
+        void emit_fcn_node(::MIR::TypeResolve& mir_res, const NodeRef& nr, const ::std::vector<bool>& labelled, unsigned indent_level)
         {
             auto indent = RepeatLitStr { "\t", static_cast<int>(indent_level) };
-            TU_MATCHA( (node), (e),
+            if( !nr.node )
+            {
+                const auto& bb = mir_res.m_fcn.blocks.at(nr.bb_idx);
+                if( labelled.at(nr.bb_idx) ) {
+                    m_of << "bb" << nr.bb_idx << ":;\n";
+                }
+                for(const auto& stmt : bb.statements)
+                {
+                    mir_res.set_cur_stmt(nr.bb_idx, (&stmt - &bb.statements.front()));
+                    this->emit_statement(mir_res, stmt, indent_level);
+                }
+                mir_res.set_cur_stmt_term(nr.bb_idx);
+                DEBUG("- " << bb.terminator);
+                // Control flow is handled by the surrounding nodes, just emit terminators with side-effects
+                TU_MATCH_DEF( ::MIR::Terminator, (bb.terminator), (te),
+                (
+                    ),
+                (Incomplete,
+                    m_of << indent << "for(;;);\n";
+                    ),
+                (Return,
+                    m_of << indent << "return rv;\n";
+                    ),
+                (Diverge,
+                    m_of << indent << "_Unwind_Resume();\n";
+                    ),
+                (Call,
+                    this->emit_term_call(mir_res, te, indent_level);
+                    )
+                )
+                m_of << indent << "// ^ " << bb.terminator << "\n";
+                return ;
+            }
+            TU_MATCHA( (*nr.node), (e),
             (Block,
-                for(size_t i = 0; i < e.nodes.size(); i ++)
+                for(const auto& snr : e.nodes)
                 {
-                    const auto& snr = e.nodes[i];
-                    if( snr.node ) {
-                        emit_fcn_node(mir_res, *snr.node, indent_level);
-                    }
-                    else {
-                        DEBUG(mir_res << "BB" << snr.bb_idx);
-                        m_of << indent << "bb" << snr.bb_idx << ":\n";
-                        const auto& bb = mir_res.m_fcn.blocks.at(snr.bb_idx);
-                        for(const auto& stmt : bb.statements)
-                        {
-                            mir_res.set_cur_stmt(snr.bb_idx, (&stmt - &bb.statements.front()));
-                            this->emit_statement(mir_res, stmt, indent_level);
-                        }
-
-                        TU_MATCHA( (bb.terminator), (te),
-                        (Incomplete, ),
-                        (Return,
-                            assert(i == e.nodes.size()-1 && "Return");
-                            m_of << indent << "return;\n";
-                            ),
-                        (Goto,
-                            // Ignore (handled by caller)
-                            ),
-                        (Diverge,
-                            ),
-                        (Panic,
-                            ),
-                        (If,
-                            //assert(i == e.nodes.size()-1 && "If");
-                            ),
-                        (Call,
-                            // TODO: Emit call
-                            emit_term_call(mir_res, te, indent_level);
-                            ),
-                        (Switch,
-                            //assert(i == e.nodes.size()-1 && "Switch");
-                            ),
-                        (SwitchValue,
-                            //assert(i == e.nodes.size()-1 && "Switch");
-                            )
-                        )
-                    }
+                    this->emit_fcn_node(mir_res, snr, labelled, indent_level);
                 }
                 ),
             (If,
-                m_of << indent << "if("; emit_lvalue(*e.val); m_of << ") {\n";
-                if( e.arm_true.node ) {
-                    emit_fcn_node(mir_res, *e.arm_true.node, indent_level+1);
-                }
-                else {
-                    m_of << indent << "\tgoto bb" << e.arm_true.bb_idx << ";\n";
-                }
-                m_of << indent << "}\n";
-                m_of << indent << "else {\n";
-                if( e.arm_false.node ) {
-                    emit_fcn_node(mir_res, *e.arm_false.node, indent_level+1);
+                const auto& cond = mir_res.m_fcn.blocks.at(e.bb_idx).terminator.as_If().cond;
+                mir_res.set_cur_stmt_term(e.bb_idx);
+                if( e.arm_true.is_empty() )
+                {
+                    m_of << indent << "if( !"; emit_lvalue(cond); m_of << " ) {\n";
+                    this->emit_fcn_node(mir_res, e.arm_false, labelled, indent_level+1);
                 }
-                else {
-                    m_of << indent << "\tgoto bb" << e.arm_false.bb_idx << ";\n";
+                else
+                {
+                    m_of << indent << "if( "; emit_lvalue(cond); m_of << " ) {\n";
+                    this->emit_fcn_node(mir_res, e.arm_true, labelled, indent_level+1);
+                    if( !e.arm_false.is_empty() )
+                    {
+                        m_of << indent << "}\n";
+                        m_of << indent << "else {\n";
+                        this->emit_fcn_node(mir_res, e.arm_false, labelled, indent_level+1);
+                    }
                 }
                 m_of << indent << "}\n";
                 ),
             (Switch,
-                this->emit_term_switch(mir_res, *e.val, e.arms.size(), indent_level, [&](auto idx) {
-                    const auto& arm = e.arms.at(idx);
-                    if( arm.node ) {
-                        m_of << "{\n";
-                        this->emit_fcn_node(mir_res, *arm.node, indent_level+1);
-                        m_of << indent  << "\t} ";
-                        if( arm.has_target() && arm.target() != e.next_bb ) {
-                            m_of << "goto bb" << arm.target() << ";";
-                        }
-                        else {
-                            m_of << "break;";
-                        }
+                const auto& term = mir_res.m_fcn.blocks.at(e.bb_idx).terminator;
+                mir_res.set_cur_stmt_term(e.bb_idx);
+                auto emit_arm = [&](size_t idx) {
+                    const auto& arm = (idx == SIZE_MAX ? e.arms.back() : e.arms.at(idx));
+                    // A lone jump is written in-line (e.g. `case 1: goto bb5;`)
+                    const auto& arm_nodes = arm.node->as_Block().nodes;
+                    if( arm_nodes.size() == 1 && arm_nodes[0].node && arm_nodes[0].node->is_Goto() ) {
+                        m_of << "goto bb" << arm_nodes[0].node->as_Goto().bb_idx << ";";
+                    }
+                    else if( arm_nodes.size() == 1 && arm_nodes[0].node && arm_nodes[0].node->is_Continue() ) {
+                        m_of << "continue;";
                     }
                     else {
-                        m_of << "goto bb" << arm.bb_idx << ";";
+                        m_of << "{\n";
+                        this->emit_fcn_node(mir_res, arm, labelled, indent_level+1);
+                        m_of << indent << "}";
                     }
-                    });
+                    };
+                if( term.is_Switch() ) {
+                    this->emit_term_switch(mir_res, term.as_Switch().val, e.arms.size(), indent_level, emit_arm);
+                }
+                else {
+                    const auto& st = term.as_SwitchValue();
+                    this->emit_term_switchvalue(mir_res, st.val, st.values, indent_level, emit_arm);
+                }
                 ),
             (Loop,
                 m_of << indent << "for(;;) {\n";
-                assert(e.code.node);
-                assert(e.code.node->is_Block());
-                this->emit_fcn_node(mir_res, *e.code.node, indent_level+1);
+                this->emit_fcn_node(mir_res, e.code, labelled, indent_level+1);
                 m_of << indent << "}\n";
+                ),
+            (Goto,
+                m_of << indent << "goto bb" << e.bb_idx << ";\n";
+                ),
+            (Continue,
+                m_of << indent << "continue;\n";
+                ),
+            (Break,
+                m_of << indent << "break;\n";
                 )
             )
         }
@@ -2129,6 +2416,19 @@ namespace {
             return m_options.emulated_i128 && (ty == ::HIR::CoreType::I128 || ty == ::HIR::CoreType::U128);
         }
 
+        void emit_drop_flag_word(unsigned int idx)
+        {
+            m_of << "dfw" << (idx / 64);
+        }
+        void emit_drop_flag_mask(unsigned int idx)
+        {
+            m_of << "0x" << ::std::hex << (uint64_t(1) << (idx % 64)) << ::std::dec << "ull";
+        }
+        void emit_drop_flag_test(unsigned int idx)
+        {
+            m_of << "("; emit_drop_flag_word(idx); m_of << " & "; emit_drop_flag_mask(idx); m_of << ")";
+        }
+
         void emit_statement(const ::MIR::TypeResolve& mir_res, const ::MIR::Statement& stmt, unsigned indent_level=1)
         {
             auto indent = RepeatLitStr { "\t", static_cast<int>(indent_level) };
@@ -2140,20 +2440,26 @@ namespace {
                 break;
             case ::MIR::Statement::TAG_SetDropFlag: {
                 const auto& e = stmt.as_SetDropFlag();
-                m_of << indent << "df" << e.idx << " = ";
-                if( e.other == ~0u )
-                    m_of << e.new_val;
-                else
-                    m_of << (e.new_val ? "!" : "") << "df" << e.other;
-                m_of << ";\n";
+                m_of << indent;
+                if( e.other == ~0u ) {
+                    emit_drop_flag_word(e.idx); m_of << (e.new_val ? " |= " : " &= ~"); emit_drop_flag_mask(e.idx);
+                }
+                else {
+                    // Clear then set if `other` is set (or clear, if negated)
+                    emit_drop_flag_word(e.idx); m_of << " = ("; emit_drop_flag_word(e.idx); m_of << " & ~"; emit_drop_flag_mask(e.idx); m_of << ")";
+                    m_of << " | ("; emit_drop_flag_test(e.other); m_of << (e.new_val ? " ? 0 : " : " ? "); emit_drop_flag_mask(e.idx);
+                    m_of << (e.new_val ? ")" : " : 0)");
+                }
+                m_of << ";\t// " << stmt << "\n";
                 break; }
             case ::MIR::Statement::TAG_Drop: {
                 const auto& e = stmt.as_Drop();
                 ::HIR::TypeRef  tmp;
                 const auto& ty = mir_res.get_lvalue_type(tmp, e.slot);
 
-                if( e.flag_idx != ~0u )
-                    m_of << indent << "if( df" << e.flag_idx << " ) {\n";
+                if( e.flag_idx != ~0u ) {
+                    m_of << indent << "if( "; emit_drop_flag_test(e.flag_idx); m_of << " ) {\n";
+                }
 
                 switch( e.kind )
                 {
@@ -2775,6 +3081,70 @@ namespace {
                 m_of << indent << "}\n";
             }
         }
+        /// Emit a multi-way value dispatch, `cb` is called with the index of the target (or SIZE_MAX for the default)
+        void emit_term_switchvalue(const ::MIR::TypeResolve& mir_res, const ::MIR::LValue& val, const ::MIR::SwitchValues& values, unsigned indent_level, ::std::function<void(size_t)> cb)
+        {
+            auto indent = RepeatLitStr { "\t", static_cast<int>(indent_level) };
+            TU_MATCHA( (values), (ve),
+            (Unsigned,
+                m_of << indent << "switch("; emit_lvalue(val); m_of << ") {\n";
+                for(size_t j = 0; j < ve.size(); j ++)
+                {
+                    m_of << indent << "case " << ::std::dec << ve[j] << "ull: ";
+                    cb(j);
+                    m_of << "\n";
+                }
+                m_of << indent << "default: ";
+                cb(SIZE_MAX);
+                m_of << "\n";
+                m_of << indent << "}\n";
+                ),
+            (Signed,
+                m_of << indent << "switch("; emit_lvalue(val); m_of << ") {\n";
+                for(size_t j = 0; j < ve.size(); j ++)
+                {
+                    m_of << indent << "case ";
+                    if( ve[j] == INT64_MIN )
+                        m_of << "INT64_MIN";
+                    else
+                        m_of << ::std::dec << ve[j] << "ll";
+                    m_of << ": ";
+                    cb(j);
+                    m_of << "\n";
+                }
+                m_of << indent << "default: ";
+                cb(SIZE_MAX);
+                m_of << "\n";
+                m_of << indent << "}\n";
+                ),
+            (String,
+                // Switch on the length, then compare the contents against only the values of that length
+                // - Arms never fall out, so a length with no matching value leaves the switch for the default
+                ::std::map<size_t, ::std::vector<size_t>>   len_buckets;
+                for(size_t j = 0; j < ve.size(); j ++)
+                    len_buckets[ve[j].size()].push_back(j);
+                m_of << indent << "switch("; emit_lvalue(val); m_of << ".META) {\n";
+                for(const auto& b : len_buckets)
+                {
+                    m_of << indent << "case " << ::std::dec << b.first << "ull:\n";
+                    for(auto j : b.second)
+                    {
+                        m_of << indent << "\t";
+                        if( b.first > 0 ) {
+                            m_of << "if( memcmp("; emit_lvalue(val); m_of << ".PTR, "; this->print_escaped_string(ve[j]); m_of << ", " << b.first << ") == 0 ) ";
+                        }
+                        cb(j);
+                        m_of << "\n";
+                    }
+                    m_of << indent << "\tbreak;\n";
+                }
+                m_of << indent << "}\n";
+                m_of << indent;
+                cb(SIZE_MAX);
+                m_of << "\n";
+                )
+            )
+        }
         void emit_term_call(const ::MIR::TypeResolve& mir_res, const ::MIR::Terminator::Data_Call& e, unsigned indent_level)
         {
             auto indent = RepeatLitStr { "\t", static_cast<int>(indent_level) };
@@ -4122,6 +4492,32 @@ namespace {
                 this->print_escaped_string(e);
                 m_of << ";\n\t";
                 emit_dst(); m_of << ".META = " << e.size();
+                ),
+            (Repeat,
+                MIR_ASSERT(*m_mir_res, ty.m_data.is_Array(), "Repeat literal for non-array type - " << ty);
+                const auto& ity = *ty.m_data.as_Array().inner;
+                if( is_zero_literal(*e.val) )
+                {
+                    m_of << "memset(&"; emit_dst(); m_of << ", 0, sizeof("; emit_dst(); m_of << "))";
+                }
+                else if( e.val->is_Integer() || e.val->is_Float() )
+                {
+                    m_of << "for(unsigned int i = 0; i < " << e.count << "; i ++)\n\t\t";
+                    assign_from_literal([&](){ emit_dst(); m_of << ".DATA[i]"; }, ity, *e.val);
+                }
+                else
+                {
+                    for(uint64_t i = 0; i < e.count; i ++) {
+                        if(i != 0)  m_of << ";\n\t";
+                        assign_from_literal([&](){ emit_dst(); m_of << ".DATA[" << i << "]"; }, ity, *e.val);
+                    }
+                }
+                ),
+            (Bytes,
+                MIR_ASSERT(*m_mir_res, ty.m_data.is_Array(), "Bytes literal for non-array type - " << ty);
+                m_of << "memcpy(&"; emit_dst(); m_of << ", ";
+                this->print_escaped_string(::std::string(e.begin(), e.end()));
+                m_of << ", " << e.size() << ")";
                 )
             )
         }
@@ -4640,7 +5036,7 @@ namespace {
     Span CodeGenerator_C::sp;
 }
 
-::std::unique_ptr<CodeGenerator> Trans_Codegen_GetGeneratorC(const ::HIR::Crate& crate, const ::std::string& outfile)
+::std::unique_ptr<CodeGenerator> Trans_Codegen_GetGeneratorC(const ::HIR::Crate& crate, const ::std::string& outfile, const TransOptions& opt)
 {
-    return ::std::unique_ptr<CodeGenerator>(new CodeGenerator_C(crate, outfile));
+    return ::std::unique_ptr<CodeGenerator>(new CodeGenerator_C(crate, outfile, opt));
 }
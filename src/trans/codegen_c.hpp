@@ -1,4 +1,9 @@
 /*
+ * MRustC - Rust Compiler
+ * - By John Hodge (Mutabah/thePowersGang)
+ *
+ * trans/codegen_c.hpp
+ * - Structured (loop/if/switch) form of MIR, used by the C backend
  */
 #pragma once
 #include <vector>
@@ -6,6 +11,7 @@
 
 class Node;
 
+/// Either a nested node, or a leaf basic block (its statements and any terminator side-effect, e.g. a call)
 struct NodeRef
 {
     ::std::unique_ptr<Node>    node;
@@ -14,34 +20,41 @@ struct NodeRef
     NodeRef(size_t idx): bb_idx(idx) {}
     NodeRef(Node node);
 
-    bool has_target() const;
-    size_t target() const;
-
-    bool operator==(size_t idx) const {
-        return !node && bb_idx == idx;
-    }
+    /// True for an empty sequence (e.g. an `if` arm that just continues on)
+    bool is_empty() const;
 };
 
 TAGGED_UNION(Node, Block,
+// Sequence of nodes, executed in order
 (Block, struct {
-    size_t  next_bb;
     ::std::vector<NodeRef>  nodes;
     }),
+// `if`/`else` on the `If` terminator of `bb_idx`
 (If, struct {
-    size_t  next_bb;
-    const ::MIR::LValue* val;
-    NodeRef arm_false;
+    size_t  bb_idx;
     NodeRef arm_true;
+    NodeRef arm_false;
     }),
+// `switch` on the `Switch`/`SwitchValue` terminator of `bb_idx`
+// - One arm per target, with the `SwitchValue` default last. Arms never fall out of the switch.
 (Switch, struct {
-    size_t  next_bb;
-    const ::MIR::LValue* val;
+    size_t  bb_idx;
     ::std::vector<NodeRef>  arms;
     }),
+// `for(;;)` with `bb_idx` as the loop header, only left with a `Break` or `Goto` (or a return)
 (Loop, struct {
-    size_t  next_bb;
+    size_t  bb_idx;
     NodeRef code;
-    })
+    }),
+// Jump to a block that isn't the next one emitted (fallback for irreducible control flow)
+(Goto, struct {
+    size_t  bb_idx;
+    }),
+// Jump to the header of the innermost loop
+(Continue, struct {}),
+// Jump to the block following the innermost loop
+(Break, struct {})
 );
 
-extern ::std::vector<Node> MIR_To_Structured(const ::MIR::Function& fcn);
+/// Convert a function's MIR into structured form, `out_labelled` is set for blocks that are the target of a `Goto`
+extern Node MIR_To_Structured(const ::MIR::Function& fcn, ::std::vector<bool>& out_labelled);
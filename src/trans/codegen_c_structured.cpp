@@ -3,7 +3,13 @@
  * - By John Hodge (Mutabah/thePowersGang)
  *
  * trans/codegen_c_structured.cpp
- * - Converts MIR into a semi-structured form
+ * - Converts MIR into a structured form (loops, if/else, switch)
+ *
+ * Based on the dominator tree of the MIR graph (see Ramsey, "Beyond Relooper", 2022)
+ * - A block only reachable from one forward edge is nested at the source of that edge
+ * - Other blocks (merge points) are emitted after the code of their immediate dominator
+ * - Loop headers (targets of back edges that dominate the edge's source) become `for(;;)`
+ * - Anything else (e.g. irreducible control flow) becomes a `goto`
  */
 #include <common.hpp>
 #include <mir/mir.hpp>
@@ -15,284 +21,416 @@ NodeRef::NodeRef(Node node_data):
     bb_idx(SIZE_MAX)
 {
 }
-bool NodeRef::has_target() const
+bool NodeRef::is_empty() const
 {
-    if( node ) {
-        TU_MATCHA( (*this->node), (e),
-        (Block,
-            return e.next_bb != SIZE_MAX;
+    return node && node->is_Block() && node->as_Block().nodes.empty();
+}
+
+namespace {
+    const size_t NONE = SIZE_MAX;
+
+    // NOTE: The panic arm of calls is not emitted by the C backend, so isn't a successor here
+    void get_successors(const ::MIR::Terminator& term, ::std::vector<size_t>& out)
+    {
+        out.clear();
+        TU_MATCHA( (term), (te),
+        (Incomplete,
             ),
-        (If,
-            return e.next_bb != SIZE_MAX;
+        (Return,
             ),
-        (Switch,
-            return e.next_bb != SIZE_MAX;
+        (Diverge,
             ),
-        (Loop,
-            return e.next_bb != SIZE_MAX;
-            )
-        )
-        throw "";
-    }
-    else {
-        return true;
-    }
-}
-size_t NodeRef::target() const
-{
-    if( node ) {
-        TU_MATCHA( (*this->node), (e),
-        (Block,
-            return e.next_bb;
+        (Goto,
+            out.push_back(te);
+            ),
+        (Panic,
+            out.push_back(te.dst);
             ),
         (If,
-            return e.next_bb;
+            out.push_back(te.bb0);
+            out.push_back(te.bb1);
             ),
         (Switch,
-            return e.next_bb;
+            for(auto tgt : te.targets)
+                out.push_back(tgt);
             ),
-        (Loop,
-            return e.next_bb;
+        (SwitchValue,
+            for(auto tgt : te.targets)
+                out.push_back(tgt);
+            out.push_back(te.def_target);
+            ),
+        (Call,
+            out.push_back(te.ret_block);
             )
         )
-        throw "";
-    }
-    else {
-        return bb_idx;
     }
 }
 
 class Converter
 {
     const ::MIR::Function& m_fcn;
+
+    ::std::vector<size_t>   m_rpo;          // Reachable blocks in reverse post-order
+    ::std::vector<size_t>   m_rpo_index;    // NONE for unreachable blocks
+    ::std::vector<size_t>   m_idom;
+    ::std::vector<bool>     m_is_loop_header;
+    ::std::vector<size_t>   m_loop_of;      // Innermost loop header containing the block
+    ::std::vector<size_t>   m_parent_loop;  // For loop headers, the enclosing loop's header
+
+    // Source of the single forward edge that a block is nested at (NONE if emitted as a follow block)
+    ::std::vector<size_t>   m_inline_at;
+    // Blocks emitted after the code of this block (in RPO)
+    ::std::vector< ::std::vector<size_t> >  m_follows;
+
+    struct Context {
+        size_t  fallthrough;    // Block that is reached by running off the end of the current sequence
+        size_t  break_target;   // Block following the innermost loop (NONE if `break` isn't usable)
+        size_t  loop_header;    // Innermost loop (NONE if outside a loop)
+    };
+
 public:
-    ::std::vector<unsigned> m_block_ref_count;
-    ::std::vector<bool> m_blocks_used;
+    ::std::vector<bool> m_labelled;
 
     Converter(const ::MIR::Function& fcn):
         m_fcn(fcn)
     {
-
     }
 
-    // Returns true if the passed block is the start of a self-contained sequence of blocks
-    bool bb_is_opening(size_t bb_idx)
+    void analyse()
     {
-        if( m_blocks_used[bb_idx] ) {
-            return false;
-        }
-        else if( m_block_ref_count[bb_idx] > 1 ) {
-            // TODO: Determine if these multiple references are from the block looping back on itself
-            return false;
-        }
-        else {
-            return true;
-        }
-    }
-    NodeRef process_node_ref(size_t bb_idx)
-    {
-        if( bb_is_opening(bb_idx) ) {
-            return NodeRef( process_node(bb_idx) );
-        }
-        else {
-            return NodeRef(bb_idx);
-        }
-    }
+        const size_t n_blocks = m_fcn.blocks.size();
+        ::std::vector< ::std::vector<size_t> >  succs(n_blocks);
+        for(size_t i = 0; i < n_blocks; i ++)
+            get_successors(m_fcn.blocks[i].terminator, succs[i]);
 
-    Node process_node(size_t bb_idx)
-    {
-        TRACE_FUNCTION_F(bb_idx);
-        ::std::vector<NodeRef> refs;
-        for(;;)
+        // Reverse post-order (iterative DFS, functions can have many thousands of blocks)
+        m_rpo_index.assign(n_blocks, NONE);
         {
-            DEBUG("bb_idx = " << bb_idx);
-            bool stop = false;
-            assert( !m_blocks_used[bb_idx] );
-            m_blocks_used[bb_idx] = true;
-
-            refs.push_back( NodeRef(bb_idx) );
-
-            const auto& blk = m_fcn.blocks.at(bb_idx);
-            DEBUG("> " << blk.terminator);
-            TU_MATCHA( (blk.terminator), (te),
-            (Incomplete,
-                stop = true;
-                ),
-            (Goto,
-                bb_idx = te;
-                ),
-            (Panic,
-                TODO(Span(), "Panic");
-                ),
-            (Diverge,
-                stop = true;
-                ),
-            (Return,
-                stop = true;
-                ),
-            (If,
-                auto arm0 = process_node_ref(te.bb0);
-                auto arm1 = process_node_ref(te.bb1);
-                if( arm0.has_target() && arm1.has_target() ) {
-                    if( arm0.target() == arm1.target() ) {
-                        bb_idx = arm0.target();
-                    }
-                    else {
-                        stop = true;
+            ::std::vector<bool> visited(n_blocks);
+            ::std::vector< ::std::pair<size_t,size_t> > stack;
+            stack.push_back(::std::make_pair(0, 0));
+            visited[0] = true;
+            while( !stack.empty() )
+            {
+                auto& top = stack.back();
+                if( top.second < succs[top.first].size() )
+                {
+                    auto next = succs[top.first][top.second++];
+                    if( !visited[next] ) {
+                        visited[next] = true;
+                        stack.push_back(::std::make_pair(next, 0));
                     }
                 }
-                else if( arm0.has_target() ) {
-                    bb_idx = arm0.target();
-                }
-                else if( arm1.has_target() ) {
-                    bb_idx = arm1.target();
-                }
-                else {
-                    // No target from either arm
-                    stop = false;
-                }
-                refs.push_back(Node::make_If({ bb_idx, &te.cond, mv$(arm0), mv$(arm1) }));
-                ),
-            (Switch,
-                ::std::vector<NodeRef>  arms;
-                ::std::vector<size_t>   next_blocks;
-                for(auto& tgt : te.targets)
+                else
                 {
-                    arms.push_back( process_node_ref(tgt) );
-                    if( arms.back().has_target() )
-                    {
-                        next_blocks.push_back( arms.back().target() );
-                    }
+                    m_rpo.push_back(top.first);
+                    stack.pop_back();
                 }
-                ::std::sort(next_blocks.begin(), next_blocks.end());
-                size_t  exit_bb = SIZE_MAX;
-                if(!next_blocks.empty())
+            }
+            ::std::reverse(m_rpo.begin(), m_rpo.end());
+            for(size_t i = 0; i < m_rpo.size(); i ++)
+                m_rpo_index[m_rpo[i]] = i;
+        }
+
+        ::std::vector< ::std::vector<size_t> >  preds(n_blocks);
+        for(auto bb : m_rpo)
+            for(auto s : succs[bb])
+                preds[s].push_back(bb);
+
+        // Immediate dominators (Cooper, Harvey, Kennedy - "A Simple, Fast Dominance Algorithm")
+        m_idom.assign(n_blocks, NONE);
+        m_idom[0] = 0;
+        for(bool changed = true; changed; )
+        {
+            changed = false;
+            for(size_t i = 1; i < m_rpo.size(); i ++)
+            {
+                auto bb = m_rpo[i];
+                size_t new_idom = NONE;
+                for(auto p : preds[bb])
                 {
-                    size_t  cur = next_blocks[0];
-                    size_t  cur_count = 0;
-                    size_t  max_count = 0;
-                    for(auto b : next_blocks)
-                    {
-                        if(cur == b) {
-                            cur_count ++;
-                        }
-                        else {
-                            if( cur_count > max_count ) {
-                                exit_bb = cur;
-                            }
-                            cur = b;
-                            cur_count = 1;
-                        }
+                    if( m_idom[p] == NONE )
+                        continue ;
+                    if( new_idom == NONE ) {
+                        new_idom = p;
+                        continue ;
                     }
-                    if( cur_count > max_count ) {
-                        exit_bb = cur;
+                    auto a = p, b = new_idom;
+                    while( a != b ) {
+                        while( m_rpo_index[a] > m_rpo_index[b] )  a = m_idom[a];
+                        while( m_rpo_index[b] > m_rpo_index[a] )  b = m_idom[b];
                     }
+                    new_idom = a;
                 }
-                refs.push_back(Node::make_Switch({ exit_bb, &te.val, mv$(arms) }));
-                stop = true;
-                ),
-            (SwitchValue,
-                TODO(Span(), "SwitchValue");
-                ),
-            (Call,
-                // NOTE: Let the panic arm just be a goto
-                bb_idx = te.ret_block;
-                )
-            )
+                if( m_idom[bb] != new_idom ) {
+                    m_idom[bb] = new_idom;
+                    changed = true;
+                }
+            }
+        }
 
-            if( stop )
+        // Loops: a back edge is an edge to a block that dominates the source
+        // - Headers are visited in RPO, so inner loops (which have later headers) overwrite `m_loop_of`
+        m_is_loop_header.assign(n_blocks, false);
+        m_loop_of.assign(n_blocks, NONE);
+        m_parent_loop.assign(n_blocks, NONE);
+        for(auto hdr : m_rpo)
+        {
+            ::std::vector<size_t>   todo;
+            for(auto p : preds[hdr])
+                if( this->dominates(hdr, p) )
+                    todo.push_back(p);
+            if( todo.empty() )
+                continue ;
+            m_is_loop_header[hdr] = true;
+            m_parent_loop[hdr] = m_loop_of[hdr];
+
+            // Natural loop: everything that reaches a back edge without passing through the header
+            ::std::vector<bool> in_loop(n_blocks);
+            in_loop[hdr] = true;
+            m_loop_of[hdr] = hdr;
+            while( !todo.empty() )
             {
-                break;
+                auto bb = todo.back();
+                todo.pop_back();
+                if( in_loop[bb] )
+                    continue ;
+                in_loop[bb] = true;
+                m_loop_of[bb] = hdr;
+                for(auto p : preds[bb])
+                    todo.push_back(p);
             }
+        }
 
-            // If `bb_idx` is in `refs` as a NodeRef
-            auto it = ::std::find(refs.begin(), refs.end(), bb_idx);
-            if( it != refs.end() )
+        // Decide where each block is emitted
+        m_inline_at.assign(n_blocks, NONE);
+        m_follows.resize(n_blocks);
+        for(size_t i = 1; i < m_rpo.size(); i ++)
+        {
+            auto bb = m_rpo[i];
+            size_t  owner = NONE;
+            unsigned n_forward = 0;
+            for(auto p : preds[bb])
             {
-                // Wrap ibb_idxms from `it` to `refs.end()` in a `loop` block
-                ::std::vector<NodeRef> loop_blocks;
-                loop_blocks.reserve(refs.end() - it);
-                for(auto it2 = it; it2 != refs.end(); ++it2)
-                    loop_blocks.push_back( mv$(*it2) );
-                auto loop_node = NodeRef( Node::make_Block({ SIZE_MAX, mv$(loop_blocks) }) );
-
-                refs.push_back( Node::make_Loop({ SIZE_MAX, mv$(loop_node) }) );
-                // TODO: If there is only one `goto` in the above loop, assume it's the target
-                DEBUG("Loop");
-                break;
+                if( m_rpo_index[p] < m_rpo_index[bb] ) {
+                    owner = p;
+                    n_forward ++;
+                }
             }
-            else if( bb_is_opening(bb_idx) )
+            assert(n_forward > 0);
+            bool can_inline = (n_forward == 1);
+            if( !can_inline )
+                owner = m_idom[bb];
+            // Blocks outside a loop are emitted after it (instead of within the loop body)
+            for(auto l = m_loop_of[owner]; l != NONE && !this->is_in_loop(bb, l); l = m_parent_loop[l])
             {
-                DEBUG("Destination " << bb_idx << " is unreferenced+unvisited");
+                owner = l;
+                can_inline = false;
             }
+
+            if( can_inline )
+                m_inline_at[bb] = owner;
             else
-            {
+                m_follows[owner].push_back(bb);
+        }
+
+        m_labelled.assign(n_blocks, false);
+    }
+
+    Node convert()
+    {
+        ::std::vector<NodeRef>  nodes;
+        this->emit_tree(0, Context { NONE, NONE, NONE }, nodes);
+        return Node::make_Block({ mv$(nodes) });
+    }
+
+private:
+    bool dominates(size_t a, size_t b) const
+    {
+        if( m_idom[b] == NONE )
+            return false;
+        while( b != a && b != 0 )
+            b = m_idom[b];
+        return b == a;
+    }
+    bool is_in_loop(size_t bb, size_t hdr) const
+    {
+        for(auto l = m_loop_of[bb]; l != NONE; l = m_parent_loop[l])
+            if( l == hdr )
+                return true;
+        return false;
+    }
+
+    void emit_tree(size_t bb, const Context& ctx, ::std::vector<NodeRef>& out)
+    {
+        if( m_is_loop_header[bb] )
+        {
+            ::std::vector<size_t>   inner, outer;
+            for(auto f : m_follows[bb])
+                (this->is_in_loop(f, bb) ? inner : outer).push_back(f);
+
+            // Running off the end of the loop body goes back to the header
+            Context inner_ctx { bb, (outer.empty() ? ctx.fallthrough : outer.front()), bb };
+            ::std::vector<NodeRef>  body;
+            this->emit_within(bb, inner, inner_ctx, body);
+            out.push_back(Node::make_Loop({ bb, NodeRef(Node::make_Block({ mv$(body) })) }));
+
+            this->emit_follows(outer, ctx, out);
+        }
+        else
+        {
+            this->emit_within(bb, m_follows[bb], ctx, out);
+        }
+    }
+
+    // Emit `bb`, then its follow blocks
+    // - Chains of unconditional jumps to nested blocks are emitted iteratively (avoids deep recursion)
+    void emit_within(size_t bb, const ::std::vector<size_t>& follows, const Context& ctx, ::std::vector<NodeRef>& out)
+    {
+        ::std::vector<const ::std::vector<size_t>*>  chain_follows;
+        chain_follows.push_back(&follows);
+        for(;;)
+        {
+            out.push_back(NodeRef(bb));
+            auto next = this->get_chain_next(bb);
+            if( next == NONE )
                 break;
-            }
+            bb = next;
+            chain_follows.push_back(&m_follows[bb]);
         }
 
-        return Node::make_Block({ bb_idx, mv$(refs) });
+        // The follow blocks of the last chain entry come first, then the previous entry's...
+        auto get_fallthrough = [&](size_t from)->size_t {
+            for(size_t i = from; i --; )
+                if( !chain_follows[i]->empty() )
+                    return chain_follows[i]->front();
+            return ctx.fallthrough;
+            };
+
+        Context term_ctx = ctx;
+        term_ctx.fallthrough = get_fallthrough(chain_follows.size());
+        this->emit_terminator(bb, term_ctx, out);
+
+        for(size_t i = chain_follows.size(); i --; )
+        {
+            Context follow_ctx = ctx;
+            follow_ctx.fallthrough = get_fallthrough(i);
+            this->emit_follows(*chain_follows[i], follow_ctx, out);
+        }
+    }
+    void emit_follows(const ::std::vector<size_t>& follows, const Context& ctx, ::std::vector<NodeRef>& out)
+    {
+        for(size_t i = 0; i < follows.size(); i ++)
+        {
+            Context c = ctx;
+            c.fallthrough = (i+1 < follows.size() ? follows[i+1] : ctx.fallthrough);
+            this->emit_tree(follows[i], c, out);
+        }
     }
-};
 
-::std::vector<Node> MIR_To_Structured(const ::MIR::Function& fcn)
-{
-    Converter   conv(fcn);
-    conv.m_block_ref_count.resize( fcn.blocks.size() );
-    conv.m_block_ref_count[0] += 1;
-    for(const auto& blk : fcn.blocks)
+    // If `bb` ends with an unconditional jump to a (non-loop) block nested here, return that block
+    size_t get_chain_next(size_t bb) const
     {
-        TU_MATCHA( (blk.terminator), (te),
-        (Incomplete,
+        size_t  tgt = NONE;
+        TU_MATCH_DEF( ::MIR::Terminator, (m_fcn.blocks[bb].terminator), (te),
+        (
             ),
         (Goto,
-            conv.m_block_ref_count[te] += 1;
+            tgt = te;
             ),
         (Panic,
-            conv.m_block_ref_count[te.dst] += 1;
+            tgt = te.dst;
             ),
-        (Diverge,
+        (Call,
+            tgt = te.ret_block;
+            )
+        )
+        if( tgt != NONE && m_inline_at[tgt] == bb && !m_is_loop_header[tgt] )
+            return tgt;
+        return NONE;
+    }
+
+    void emit_terminator(size_t bb, const Context& ctx, ::std::vector<NodeRef>& out)
+    {
+        TU_MATCHA( (m_fcn.blocks[bb].terminator), (te),
+        (Incomplete,
             ),
         (Return,
             ),
+        (Diverge,
+            ),
+        (Goto,
+            this->emit_branch(bb, te, ctx, out);
+            ),
+        (Panic,
+            this->emit_branch(bb, te.dst, ctx, out);
+            ),
+        (Call,
+            this->emit_branch(bb, te.ret_block, ctx, out);
+            ),
         (If,
-            conv.m_block_ref_count[te.bb0] += 1;
-            conv.m_block_ref_count[te.bb1] += 1;
+            ::std::vector<NodeRef>  arm_true, arm_false;
+            this->emit_branch(bb, te.bb0, ctx, arm_true);
+            this->emit_branch(bb, te.bb1, ctx, arm_false);
+            if( !arm_true.empty() || !arm_false.empty() )
+            {
+                out.push_back(Node::make_If({ bb, NodeRef(Node::make_Block({ mv$(arm_true) })), NodeRef(Node::make_Block({ mv$(arm_false) })) }));
+            }
             ),
         (Switch,
-            for(auto tgt : te.targets)
-                conv.m_block_ref_count[tgt] += 1;
+            out.push_back(Node::make_Switch({ bb, this->emit_switch_arms(bb, te.targets, NONE, ctx) }));
             ),
         (SwitchValue,
-            for(auto tgt : te.targets)
-                conv.m_block_ref_count[tgt] += 1;
-            conv.m_block_ref_count[te.def_target] += 1;
-            ),
-        (Call,
-            conv.m_block_ref_count[te.ret_block] += 1;
-            conv.m_block_ref_count[te.panic_block] += 1;
+            out.push_back(Node::make_Switch({ bb, this->emit_switch_arms(bb, te.targets, te.def_target, ctx) }));
             )
         )
     }
-
-    // First Block: Becomes a block in structured output
-    // - Terminator selects what the next block will be
-    // - 
-
-    // Find next unvisited block
-    conv.m_blocks_used.resize( fcn.blocks.size() );
-    ::std::vector<Node> nodes;
-    for(size_t bb_idx = 0; bb_idx < fcn.blocks.size(); bb_idx ++)
+    ::std::vector<NodeRef> emit_switch_arms(size_t bb, const ::std::vector< ::MIR::BasicBlockId>& targets, size_t def_target, const Context& ctx)
     {
-        if( conv.m_blocks_used[bb_idx] )
-            continue;
-
-        nodes.push_back( conv.process_node(bb_idx) );
+        // Arms must end with an explicit jump (`break` would leave the switch, not the loop)
+        Context arm_ctx { NONE, NONE, ctx.loop_header };
+        ::std::vector<NodeRef>  arms;
+        for(auto tgt : targets)
+        {
+            ::std::vector<NodeRef>  arm;
+            this->emit_branch(bb, tgt, arm_ctx, arm);
+            arms.push_back(NodeRef(Node::make_Block({ mv$(arm) })));
+        }
+        if( def_target != NONE )
+        {
+            ::std::vector<NodeRef>  arm;
+            this->emit_branch(bb, def_target, arm_ctx, arm);
+            arms.push_back(NodeRef(Node::make_Block({ mv$(arm) })));
+        }
+        return arms;
     }
 
+    void emit_branch(size_t src, size_t tgt, const Context& ctx, ::std::vector<NodeRef>& out)
+    {
+        if( m_inline_at[tgt] == src ) {
+            this->emit_tree(tgt, ctx, out);
+        }
+        else if( tgt == ctx.fallthrough ) {
+        }
+        else if( tgt == ctx.loop_header ) {
+            out.push_back(Node::make_Continue({}));
+        }
+        else if( tgt == ctx.break_target ) {
+            out.push_back(Node::make_Break({}));
+        }
+        else {
+            m_labelled[tgt] = true;
+            out.push_back(Node::make_Goto({ tgt }));
+        }
+    }
+};
 
-    // Return.
-    return nodes;
+Node MIR_To_Structured(const ::MIR::Function& fcn, ::std::vector<bool>& out_labelled)
+{
+    TRACE_FUNCTION;
+    Converter   conv(fcn);
+    conv.analyse();
+    auto rv = conv.convert();
+    out_labelled = mv$(conv.m_labelled);
+    return rv;
 }
-
-
@@ -9,6 +9,7 @@
  */
 #include "main_bindings.hpp"
 #include "trans_list.hpp"
+#include "monomorphise.hpp"
 #include <hir/hir.hpp>
 #include <mir/mir.hpp>
 #include <hir_typeck/common.hpp>    // monomorph
@@ -16,49 +17,89 @@
 #include <hir/item_path.hpp>
 #include <deque>
 #include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <exception>
 
 namespace {
     struct EnumState
     {
         const ::HIR::Crate& crate;
         TransList   rv;
+        /// Number of worker threads used to drain `fcn_queue`
+        unsigned int    num_threads;
 
+        struct FcnEnt {
+            const ::HIR::Path*  path;
+            TransList_Function* fcn;
+        };
         // Queue of items to enumerate
-        ::std::deque<TransList_Function*>  fcn_queue;
-        ::std::vector<TransList_Function*> fcns_to_type_visit;
+        ::std::deque<FcnEnt>  fcn_queue;
+        ::std::vector<FcnEnt> fcns_to_type_visit;
+
+        // Protects `rv` and the two queues while the queue is being drained by multiple workers
+        ::std::mutex    lock;
+        ::std::condition_variable   queue_cv;
 
-        EnumState(const ::HIR::Crate& crate):
-            crate(crate)
+        EnumState(const ::HIR::Crate& crate, unsigned int num_threads):
+            crate(crate),
+            num_threads(num_threads)
         {}
 
         void enum_fcn(::HIR::Path p, const ::HIR::Function& fcn, Trans_Params pp)
         {
-            if(auto* e = rv.add_function(mv$(p)))
+            ::std::lock_guard< ::std::mutex>    lh { lock };
+            // NOTE: Not using `rv.add_function`, as the path (key) is needed for the queues
+            auto ins = rv.m_functions.insert( ::std::make_pair(mv$(p), nullptr) );
+            if( ins.second )
             {
-                fcns_to_type_visit.push_back(e);
-                e->ptr = &fcn;
-                e->pp = mv$(pp);
-                fcn_queue.push_back(e);
+                DEBUG("Function " << ins.first->first);
+                ins.first->second.reset( new TransList_Function { &fcn, mv$(pp) } );
+                FcnEnt  ent { &ins.first->first, ins.first->second.get() };
+                fcns_to_type_visit.push_back(ent);
+                fcn_queue.push_back(ent);
+                queue_cv.notify_one();
             }
         }
+        TransList_Static* add_static(::HIR::Path p)
+        {
+            ::std::lock_guard< ::std::mutex>    lh { lock };
+            return rv.add_static(mv$(p));
+        }
+        bool add_vtable(::HIR::Path p)
+        {
+            ::std::lock_guard< ::std::mutex>    lh { lock };
+            return rv.add_vtable(mv$(p), {});
+        }
+        void add_constructor(::HIR::GenericPath p)
+        {
+            ::std::lock_guard< ::std::mutex>    lh { lock };
+            rv.m_constructors.insert( mv$(p) );
+        }
+        void add_typeid(::HIR::TypeRef ty)
+        {
+            ::std::lock_guard< ::std::mutex>    lh { lock };
+            rv.m_typeids.insert( mv$(ty) );
+        }
     };
 }
 
 TransList Trans_Enumerate_CommonPost(EnumState& state);
 void Trans_Enumerate_Types(EnumState& state);
 void Trans_Enumerate_FillFrom_Path(EnumState& state, const ::HIR::Path& path, const Trans_Params& pp);
-void Trans_Enumerate_FillFrom(EnumState& state, const ::HIR::Function& function, const Trans_Params& pp);
+void Trans_Enumerate_FillFrom(EnumState& state, const ::HIR::Path& path, TransList_Function& fcn_out);
 void Trans_Enumerate_FillFrom(EnumState& state, const ::HIR::Static& stat, TransList_Static& stat_out, Trans_Params pp={});
 void Trans_Enumerate_FillFrom_VTable (EnumState& state, ::HIR::Path vtable_path, const Trans_Params& pp);
 void Trans_Enumerate_FillFrom_Literal(EnumState& state, const ::HIR::Literal& lit, const Trans_Params& pp);
 void Trans_Enumerate_FillFrom_MIR(EnumState& state, const ::MIR::Function& code, const Trans_Params& pp);
 
 /// Enumerate trans items starting from `::main` (binary crate)
-TransList Trans_Enumerate_Main(const ::HIR::Crate& crate)
+TransList Trans_Enumerate_Main(const ::HIR::Crate& crate, unsigned int num_threads)
 {
     static Span sp;
 
-    EnumState   state { crate };
+    EnumState   state { crate, num_threads };
 
     auto c_start_path = crate.get_lang_item_path_opt("mrustc-start");
     if( c_start_path == ::HIR::SimplePath() )
@@ -119,7 +160,7 @@ namespace {
                     if(e.m_type.m_data.is_Infer())
                         continue ;
                     //state.enum_static(mod_path + vi.first, *e);
-                    auto* ptr = state.rv.add_static(mod_path + vi.first);
+                    auto* ptr = state.add_static(mod_path + vi.first);
                     if(ptr)
                         Trans_Enumerate_FillFrom(state, e, *ptr);
                 }
@@ -151,10 +192,10 @@ namespace {
 }
 
 /// Enumerate trans items for all public non-generic items (library crate)
-TransList Trans_Enumerate_Public(::HIR::Crate& crate)
+TransList Trans_Enumerate_Public(::HIR::Crate& crate, unsigned int num_threads)
 {
     static Span sp;
-    EnumState   state { crate };
+    EnumState   state { crate, num_threads };
 
     Trans_Enumerate_Public_Mod(state, crate.m_root_module,  ::HIR::SimplePath(crate.m_crate_name,{}), true);
 
@@ -326,15 +367,65 @@ TransList Trans_Enumerate_Public(::HIR::Crate& crate)
 void Trans_Enumerate_CommonPost_Run(EnumState& state)
 {
     // Run the enumerate queue (keeps the recursion depth down)
-    while( !state.fcn_queue.empty() )
+    // - Debug output is only legible when single-threaded
+    if( state.num_threads <= 1 || debug_enabled() )
     {
-        auto& fcn_out = *state.fcn_queue.front();
-        state.fcn_queue.pop_front();
+        while( !state.fcn_queue.empty() )
+        {
+            auto ent = state.fcn_queue.front();
+            state.fcn_queue.pop_front();
 
-        TRACE_FUNCTION_F("Function " << ::std::find_if(state.rv.m_functions.begin(), state.rv.m_functions.end(), [&](const auto&x){ return x.second.get() == &fcn_out; })->first);
+            TRACE_FUNCTION_F("Function " << *ent.path);
 
-        Trans_Enumerate_FillFrom(state, *fcn_out.ptr, fcn_out.pp);
+            Trans_Enumerate_FillFrom(state, *ent.path, *ent.fcn);
+        }
     }
+    else
+    {
+        // Each worker pops a function, monomorphises/scans it (without the lock held), and pushes newly discovered
+        // functions back onto the queue. Enumeration is complete once the queue is empty and no worker is active.
+        unsigned int    num_active = 0;
+        ::std::exception_ptr    error;
+        auto worker = [&]() {
+            ::std::unique_lock< ::std::mutex>   lh { state.lock };
+            for(;;)
+            {
+                state.queue_cv.wait(lh, [&](){ return !state.fcn_queue.empty() || num_active == 0 || error; });
+                if( state.fcn_queue.empty() || error )
+                    break;
+                auto ent = state.fcn_queue.front();
+                state.fcn_queue.pop_front();
+                num_active += 1;
+                lh.unlock();
+
+                try
+                {
+                    Trans_Enumerate_FillFrom(state, *ent.path, *ent.fcn);
+                    lh.lock();
+                }
+                catch(...)
+                {
+                    lh.lock();
+                    if( !error )
+                        error = ::std::current_exception();
+                }
+                num_active -= 1;
+                if( error || (num_active == 0 && state.fcn_queue.empty()) )
+                    state.queue_cv.notify_all();
+            }
+        };
+        ::std::vector< ::std::thread>   threads;
+        for(unsigned int i = 1; i < state.num_threads; i ++)
+            threads.push_back( ::std::thread(worker) );
+        worker();
+        for(auto& t : threads)
+            t.join();
+        if( error )
+            ::std::rethrow_exception(error);
+    }
+
+    // Discovery order depends on thread scheduling, so visit types in path order (keeps the generated code stable)
+    ::std::sort(state.fcns_to_type_visit.begin(), state.fcns_to_type_visit.end(), [](const auto& a, const auto& b){ return *a.path < *b.path; });
 }
 TransList Trans_Enumerate_CommonPost(EnumState& state)
 {
@@ -590,8 +681,8 @@ void Trans_Enumerate_Types(EnumState& state)
         // Visit all functions that haven't been type-visited yet
         for(unsigned int i = 0; i < state.fcns_to_type_visit.size(); i++)
         {
-            auto p = state.fcns_to_type_visit[i];
-            TRACE_FUNCTION_F("Function " << ::std::find_if(state.rv.m_functions.begin(), state.rv.m_functions.end(), [&](const auto&x){ return x.second.get() == p; })->first);
+            auto p = state.fcns_to_type_visit[i].fcn;
+            TRACE_FUNCTION_F("Function " << *state.fcns_to_type_visit[i].path);
             assert(p->ptr);
             const auto& fcn = *p->ptr;
             const auto& pp = p->pp;
@@ -628,7 +719,8 @@ void Trans_Enumerate_Types(EnumState& state)
 
             if( fcn.m_code.m_mir )
             {
-                const auto& mir = *fcn.m_code.m_mir;
+                // NOTE: The monomorphised body (if present) doesn't need `pp` applied, but monomorph is a no-op on it
+                const auto& mir = p->monomorphised ? *p->monomorphised : *fcn.m_code.m_mir;
                 for(const auto& ty : mir.locals)
                     tv.visit_type(monomorph(ty));
 
@@ -636,7 +728,7 @@ void Trans_Enumerate_Types(EnumState& state)
                 for(const auto& block : mir.blocks)
                 {
                     struct H {
-                        static const ::HIR::TypeRef& visit_lvalue(TypeVisitor& tv, const Trans_Params& pp, const ::HIR::Function& fcn, const ::MIR::LValue& lv, ::HIR::TypeRef* tmp_ty_ptr = nullptr) {
+                        static const ::HIR::TypeRef& visit_lvalue(TypeVisitor& tv, const Trans_Params& pp, const ::HIR::Function& fcn, const ::MIR::Function& mir, const ::MIR::LValue& lv, ::HIR::TypeRef* tmp_ty_ptr = nullptr) {
                             static ::HIR::TypeRef   blank;
                             TRACE_FUNCTION_F(lv << (tmp_ty_ptr ? " [type]" : ""));
                             auto monomorph_outer = [&](const auto& tpl)->const auto& {
@@ -662,7 +754,7 @@ void Trans_Enumerate_Types(EnumState& state)
                                 ),
                             (Local,
                                 if( tmp_ty_ptr ) {
-                                    return monomorph_outer(fcn.m_code.m_mir->locals[e]);
+                                    return monomorph_outer(mir.locals[e]);
                                 }
                                 ),
                             (Static,
@@ -687,7 +779,7 @@ void Trans_Enumerate_Types(EnumState& state)
                                 }
                                 ),
                             (Field,
-                                const auto& ity = visit_lvalue(tv,pp,fcn,  *e.val, tmp_ty_ptr);
+                                const auto& ity = visit_lvalue(tv,pp,fcn,mir,  *e.val, tmp_ty_ptr);
                                 if( tmp_ty_ptr )
                                 {
                                     TU_MATCH_DEF(::HIR::TypeRef::Data, (ity.m_data), (te),
@@ -737,7 +829,7 @@ void Trans_Enumerate_Types(EnumState& state)
                                 ::HIR::TypeRef  tmp;
                                 if( !tmp_ty_ptr )   tmp_ty_ptr = &tmp;
 
-                                const auto& ity = visit_lvalue(tv,pp,fcn,  *e.val, tmp_ty_ptr);
+                                const auto& ity = visit_lvalue(tv,pp,fcn,mir,  *e.val, tmp_ty_ptr);
                                 TU_MATCH_DEF(::HIR::TypeRef::Data, (ity.m_data), (te),
                                 (
                                     BUG(Span(), "Deref of unexpected type - " << ity);
@@ -766,8 +858,8 @@ void Trans_Enumerate_Types(EnumState& state)
                                 )
                                 ),
                             (Index,
-                                visit_lvalue(tv,pp,fcn,  *e.idx, tmp_ty_ptr);
-                                const auto& ity = visit_lvalue(tv,pp,fcn,  *e.val, tmp_ty_ptr);
+                                visit_lvalue(tv,pp,fcn,mir,  *e.idx, tmp_ty_ptr);
+                                const auto& ity = visit_lvalue(tv,pp,fcn,mir,  *e.val, tmp_ty_ptr);
                                 if( tmp_ty_ptr )
                                 {
                                     TU_MATCH_DEF(::HIR::TypeRef::Data, (ity.m_data), (te),
@@ -784,7 +876,7 @@ void Trans_Enumerate_Types(EnumState& state)
                                 }
                                 ),
                             (Downcast,
-                                const auto& ity = visit_lvalue(tv,pp,fcn,  *e.val, tmp_ty_ptr);
+                                const auto& ity = visit_lvalue(tv,pp,fcn,mir,  *e.val, tmp_ty_ptr);
                                 if( tmp_ty_ptr )
                                 {
                                     TU_MATCH_DEF( ::HIR::TypeRef::Data, (ity.m_data), (te),
@@ -835,11 +927,11 @@ void Trans_Enumerate_Types(EnumState& state)
                             return blank;
                         }
 
-                        static void visit_param(TypeVisitor& tv, const Trans_Params& pp, const ::HIR::Function& fcn, const ::MIR::Param& p)
+                        static void visit_param(TypeVisitor& tv, const Trans_Params& pp, const ::HIR::Function& fcn, const ::MIR::Function& mir, const ::MIR::Param& p)
                         {
                             TU_MATCHA( (p), (e),
                             (LValue,
-                                H::visit_lvalue(tv, pp, fcn, e);
+                                H::visit_lvalue(tv, pp, fcn, mir, e);
                                 ),
                             (Constant,
                                 )
@@ -850,66 +942,66 @@ void Trans_Enumerate_Types(EnumState& state)
                     {
                         TU_MATCHA( (stmt), (se),
                         (Drop,
-                            H::visit_lvalue(tv,pp,fcn, se.slot);
+                            H::visit_lvalue(tv,pp,fcn,mir, se.slot);
                             ),
                         (SetDropFlag,
                             ),
                         (Asm,
                             for(const auto& v : se.outputs)
-                                H::visit_lvalue(tv,pp,fcn, v.second);
+                                H::visit_lvalue(tv,pp,fcn,mir, v.second);
                             for(const auto& v : se.inputs)
-                                H::visit_lvalue(tv,pp,fcn, v.second);
+                                H::visit_lvalue(tv,pp,fcn,mir, v.second);
                             ),
                         (ScopeEnd,
                             ),
                         (Assign,
-                            H::visit_lvalue(tv,pp,fcn, se.dst);
+                            H::visit_lvalue(tv,pp,fcn,mir, se.dst);
                             TU_MATCHA( (se.src), (re),
                             (Use,
-                                H::visit_lvalue(tv,pp,fcn, re);
+                                H::visit_lvalue(tv,pp,fcn,mir, re);
                                 ),
                             (Constant,
                                 ),
                             (SizedArray,
-                                H::visit_param(tv,pp,fcn, re.val);
+                                H::visit_param(tv,pp,fcn,mir, re.val);
                                 ),
                             (Borrow,
-                                H::visit_lvalue(tv,pp,fcn, re.val);
+                                H::visit_lvalue(tv,pp,fcn,mir, re.val);
                                 ),
                             (Cast,
-                                H::visit_lvalue(tv,pp,fcn, re.val);
+                                H::visit_lvalue(tv,pp,fcn,mir, re.val);
                                 ),
                             (BinOp,
-                                H::visit_param(tv,pp,fcn, re.val_l);
-                                H::visit_param(tv,pp,fcn, re.val_l);
+                                H::visit_param(tv,pp,fcn,mir, re.val_l);
+                                H::visit_param(tv,pp,fcn,mir, re.val_l);
                                 ),
                             (UniOp,
-                                H::visit_lvalue(tv,pp,fcn, re.val);
+                                H::visit_lvalue(tv,pp,fcn,mir, re.val);
                                 ),
                             (DstMeta,
-                                H::visit_lvalue(tv,pp,fcn, re.val);
+                                H::visit_lvalue(tv,pp,fcn,mir, re.val);
                                 ),
                             (DstPtr,
-                                H::visit_lvalue(tv,pp,fcn, re.val);
+                                H::visit_lvalue(tv,pp,fcn,mir, re.val);
                                 ),
                             (MakeDst,
-                                H::visit_param(tv,pp,fcn, re.ptr_val);
-                                H::visit_param(tv,pp,fcn, re.meta_val);
+                                H::visit_param(tv,pp,fcn,mir, re.ptr_val);
+                                H::visit_param(tv,pp,fcn,mir, re.meta_val);
                                 ),
                             (Tuple,
                                 for(const auto& v : re.vals)
-                                    H::visit_param(tv,pp,fcn, v);
+                                    H::visit_param(tv,pp,fcn,mir, v);
                                 ),
                             (Array,
                                 for(const auto& v : re.vals)
-                                    H::visit_param(tv,pp,fcn, v);
+                                    H::visit_param(tv,pp,fcn,mir, v);
                                 ),
                             (Variant,
-                                H::visit_param(tv,pp,fcn, re.val);
+                                H::visit_param(tv,pp,fcn,mir, re.val);
                                 ),
                             (Struct,
                                 for(const auto& v : re.vals)
-                                    H::visit_param(tv,pp,fcn, v);
+                                    H::visit_param(tv,pp,fcn,mir, v);
                                 )
                             )
                             )
@@ -922,25 +1014,25 @@ void Trans_Enumerate_Types(EnumState& state)
                     (Goto, ),
                     (Panic, ),
                     (If,
-                        H::visit_lvalue(tv,pp,fcn, te.cond);
+                        H::visit_lvalue(tv,pp,fcn,mir, te.cond);
                         ),
                     (Switch,
-                        H::visit_lvalue(tv,pp,fcn, te.val);
+                        H::visit_lvalue(tv,pp,fcn,mir, te.val);
                         ),
                     (SwitchValue,
-                        H::visit_lvalue(tv,pp,fcn, te.val);
+                        H::visit_lvalue(tv,pp,fcn,mir, te.val);
                         ),
                     (Call,
                         if( te.fcn.is_Value() )
-                            H::visit_lvalue(tv,pp,fcn, te.fcn.as_Value());
+                            H::visit_lvalue(tv,pp,fcn,mir, te.fcn.as_Value());
                         else if( te.fcn.is_Intrinsic() )
                         {
                             for(const auto& ty : te.fcn.as_Intrinsic().params.m_types)
                                 tv.visit_type(monomorph(ty));
                         }
-                        H::visit_lvalue(tv,pp,fcn, te.ret_val);
+                        H::visit_lvalue(tv,pp,fcn,mir, te.ret_val);
                         for(const auto& arg : te.args)
-                            H::visit_param(tv,pp,fcn, arg);
+                            H::visit_param(tv,pp,fcn,mir, arg);
                         )
                     )
                 }
@@ -1298,12 +1390,12 @@ void Trans_Enumerate_FillFrom_Path(EnumState& state, const ::HIR::Path& path, co
         {
             // Leave generation of struct/enum constructors to codgen
             // TODO: Add to a list of required constructors
-            state.rv.m_constructors.insert( mv$(path_mono.m_data.as_Generic()) );
+            state.add_constructor( mv$(path_mono.m_data.as_Generic()) );
         }
         // - <T as U>::#vtable
         else if( path_mono.m_data.is_UfcsKnown() && path_mono.m_data.as_UfcsKnown().item == "#vtable" )
         {
-            if( state.rv.add_vtable( path_mono.clone(), {} ) )
+            if( state.add_vtable( path_mono.clone() ) )
             {
                 // Fill from the vtable
                 Trans_Enumerate_FillFrom_VTable(state, mv$(path_mono), sub_pp);
@@ -1329,7 +1421,7 @@ void Trans_Enumerate_FillFrom_Path(EnumState& state, const ::HIR::Path& path, co
         state.enum_fcn(mv$(path_mono), *e, mv$(sub_pp));
         ),
     (Static,
-        if( auto* ptr = state.rv.add_static(mv$(path_mono)) )
+        if( auto* ptr = state.add_static(mv$(path_mono)) )
         {
             Trans_Enumerate_FillFrom(state, *e, *ptr, mv$(sub_pp));
         }
@@ -1496,7 +1588,7 @@ void Trans_Enumerate_FillFrom_MIR(EnumState& state, const ::MIR::Function& code,
             (Intrinsic,
                 if( e2.name == "type_id" ) {
                     // Add <T>::#type_id to the enumerate list
-                    state.rv.m_typeids.insert( pp.monomorph(state.crate, e2.params.m_types.at(0)) );
+                    state.add_typeid( pp.monomorph(state.crate, e2.params.m_types.at(0)) );
                 }
                 )
             )
@@ -1548,6 +1640,11 @@ void Trans_Enumerate_FillFrom_Literal(EnumState& state, const ::HIR::Literal& li
         Trans_Enumerate_FillFrom_Literal(state, *e, pp);
         ),
     (String,
+        ),
+    (Repeat,
+        Trans_Enumerate_FillFrom_Literal(state, *e.val, pp);
+        ),
+    (Bytes,
         )
     )
 }
@@ -1592,12 +1689,25 @@ namespace {
     }
 }
 
-void Trans_Enumerate_FillFrom(EnumState& state, const ::HIR::Function& function, const Trans_Params& pp)
+void Trans_Enumerate_FillFrom(EnumState& state, const ::HIR::Path& path, TransList_Function& fcn_out)
 {
+    const auto& function = *fcn_out.ptr;
+    const auto& pp = fcn_out.pp;
     TRACE_FUNCTION_F("Function pp=" << pp.pp_method<<"+"<<pp.pp_impl);
     if( function.m_code.m_mir )
     {
-        Trans_Enumerate_FillFrom_MIR(state, *function.m_code.m_mir, pp);
+        if( Trans_Monomorphise_Needed(function, pp) )
+        {
+            // Monomorphise (and optimise) the body once, codegen uses this copy and the scan below sees exactly
+            // what will be emitted.
+            StaticTraitResolve  resolve { state.crate };
+            fcn_out.monomorphised = Trans_Monomorphise_Function(resolve, path, function, pp);
+            Trans_Enumerate_FillFrom_MIR(state, *fcn_out.monomorphised, Trans_Params(pp.sp));
+        }
+        else
+        {
+            Trans_Enumerate_FillFrom_MIR(state, *function.m_code.m_mir, pp);
+        }
     }
     else
     {
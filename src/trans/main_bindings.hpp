@@ -17,14 +17,25 @@ struct TransOptions
 {
     unsigned int opt_level = 0;
     bool emit_debug_info = false;
+    /// Emit function bodies as loops/if/switch instead of a `goto` per basic block (`-Z flat-c` disables)
+    bool structured_c = true;
+    /// Shorten long symbol names to a prefix and hash (see `g_mangle_compact`)
+    bool compact_mangling = false;
+    /// Put the common C prelude in a header shared between crates (and precompiled, with GCC) (`-Z shared-c-prelude`)
+    /// - Off by default (the emitted C is self-contained) until a compile time improvement has been measured
+    bool shared_c_prelude = false;
+    /// Emit functions that are identical to one already emitted as an alias to it (GCC only, `-Z fold-identical`)
+    /// - Off by default until its effect on output size and codegen time/memory has been measured
+    bool fold_identical = false;
 
     ::std::vector< ::std::string>   library_search_dirs;
     ::std::vector< ::std::string>   libraries;
 };
 
-extern TransList Trans_Enumerate_Main(const ::HIR::Crate& crate);
+// NOTE: `num_threads` is the number of workers used to monomorphise/scan function bodies
+extern TransList Trans_Enumerate_Main(const ::HIR::Crate& crate, unsigned int num_threads=1);
 extern TransList Trans_Enumerate_Test(const ::HIR::Crate& crate);
 // NOTE: This also sets the saveout flags
-extern TransList Trans_Enumerate_Public(::HIR::Crate& crate);
+extern TransList Trans_Enumerate_Public(::HIR::Crate& crate, unsigned int num_threads=1);
 
 extern void Trans_Codegen(const ::std::string& outfile, const TransOptions& opt, const ::HIR::Crate& crate, const TransList& list, bool is_executable);
@@ -2,7 +2,7 @@
  * MRustC - Rust Compiler
  * - By John Hodge (Mutabah/thePowersGang)
  *
- * trans/mangling.hpp
+ * trans/mangling.cpp
  * - Name mangling support
  *
  *
@@ -15,12 +15,18 @@
  * $C = , symbol
  * $pL/$pR = Left/right paren
  * $aL/$aR = Left/right angle (<>)
+ * $h = Hash of the full name follows (compact mangling, replaces the rest of a long name)
  */
 #include "mangling.hpp"
 #include <hir/type.hpp>
 #include <hir/path.hpp>
+#include <map>
+#include <mutex>
+#include <iomanip>
 
 namespace {
+    ::FmtLambda mangle(const ::HIR::TypeRef& ty);
+
     ::std::string   escape_str(const ::std::string& s) {
         ::std::string   output;
         output.reserve(s.size() + 1);
@@ -42,178 +48,247 @@ namespace {
                 for(unsigned int i = 0; i < params.m_types.size(); i ++)
                 {
                     if(i != 0)  ss << "$C";
-                    ss << Trans_Mangle( params.m_types[i] );
+                    ss << mangle( params.m_types[i] );
                 }
                 ss << "$aR";
             }
             );
     }
-}
-
 
-::FmtLambda Trans_Mangle(const ::HIR::SimplePath& path)
-{
-    return FMT_CB(ss,
-        ss << "_ZN";
-        {
-            ::std::string   cn;
-            for(auto c : path.m_crate_name)
+    ::FmtLambda mangle(const ::HIR::SimplePath& path)
+    {
+        return FMT_CB(ss,
+            ss << "_ZN";
             {
-                if(c == '-') {
-                    cn += "$$";
+                ::std::string   cn;
+                for(auto c : path.m_crate_name.str())
+                {
+                    if(c == '-') {
+                        cn += "$$";
+                    }
+                    else if(  ('0' <= c && c <= '9')
+                           || ('A' <= c && c <= 'Z')
+                           || ('a' <= c && c <= 'z')
+                           || c == '_'
+                           )
+                    {
+                        cn += c;
+                    }
+                    else {
+                    }
                 }
-                else if(  ('0' <= c && c <= '9')
-                       || ('A' <= c && c <= 'Z')
-                       || ('a' <= c && c <= 'z')
-                       || c == '_'
-                       )
+                ss << cn.size() << cn;
+            }
+            for(const auto& comp : path.m_components) {
+                auto v = escape_str(comp);
+                ss << v.size() << v;
+            }
+            );
+    }
+    ::FmtLambda mangle(const ::HIR::GenericPath& path)
+    {
+        return FMT_CB(ss,
+            ss << mangle(path.m_path);
+            ss << emit_params(path.m_params);
+            );
+    }
+    ::FmtLambda mangle(const ::HIR::Path& path)
+    {
+        TU_MATCHA( (path.m_data), (pe),
+        (Generic,
+            return mangle(pe);
+            ),
+        (UfcsUnknown,
+            BUG(Span(), "UfcsUnknown - " << path);
+            ),
+        (UfcsKnown,
+            return FMT_CB(ss,
+                ss << "_ZRK$aL";
+                ss << mangle(*pe.type);
+                ss << "_as_";
+                ss << mangle(pe.trait);
+                ss << "$aR";
+                if( pe.item[0] == '#' )
+                    ss << (pe.item.size()-1+2) << "$H" << (pe.item.c_str()+1);
+                else
+                    ss << pe.item;
+                ss << emit_params(pe.params);
+                );
+            ),
+        (UfcsInherent,
+            return FMT_CB(ss,
+                ss << "_ZRI$aL";
+                ss << mangle(*pe.type);
+                ss << "$aR";
+                if( pe.item[0] == '#' )
+                    ss << (pe.item.size()-1+2) << "$H" << (pe.item.c_str()+1);
+                else
+                    ss << pe.item;
+                ss << emit_params(pe.params);
+                );
+            )
+        )
+        throw "";
+    }
+    ::FmtLambda mangle(const ::HIR::TypeRef& ty)
+    {
+        TU_MATCHA( (ty.m_data), (te),
+        (Infer,
+            BUG(Span(), "Infer in trans");
+            ),
+        (Diverge,
+            return FMT_CB(ss, ss << "$D";);
+            ),
+        (Primitive,
+            return FMT_CB(ss, ss << te;);
+            ),
+        (Path,
+            return mangle(te.path);
+            ),
+        (Generic,
+            BUG(Span(), "Generic in trans - " << ty);
+            ),
+        (TraitObject,
+            return FMT_CB(ss,
+                ss << "$pL";
+                ss << mangle(te.m_trait.m_path);
+                for(const auto& bound : te.m_trait.m_type_bounds) {
+                    ss << "_" << bound.first << "$E" << mangle(bound.second);
+                }
+                for(const auto& marker : te.m_markers) {
+                    ss << "$P" << mangle(marker);
+                }
+                ss << "$pR";
+                );
+            ),
+        (ErasedType,
+            BUG(Span(), "ErasedType in trans - " << ty);
+            ),
+        (Array,
+            return FMT_CB(ss, ss << "$A" << te.size_val << "_" << mangle(*te.inner););
+            ),
+        (Slice,
+            return FMT_CB(ss, ss << "$A" << "_" << mangle(*te.inner););
+            ),
+        (Tuple,
+            return FMT_CB(ss,
+                ss << "$T" << te.size();
+                for(const auto& t : te)
+                    ss << "_" << mangle(t);
+                );
+            ),
+        (Borrow,
+            return FMT_CB(ss,
+                ss << "$R";
+                switch(te.type)
                 {
-                    cn += c;
+                case ::HIR::BorrowType::Shared: ss << "s"; break;
+                case ::HIR::BorrowType::Unique: ss << "u"; break;
+                case ::HIR::BorrowType::Owned : ss << "o"; break;
                 }
-                else {
+                ss << "_" << mangle(*te.inner);
+                );
+            ),
+        (Pointer,
+            return FMT_CB(ss,
+                ss << "$S";
+                switch(te.type)
+                {
+                case ::HIR::BorrowType::Shared: ss << "s"; break;
+                case ::HIR::BorrowType::Unique: ss << "u"; break;
+                case ::HIR::BorrowType::Owned : ss << "o"; break;
                 }
-            }
-            ss << cn.size() << cn;
+                ss << "_" << mangle(*te.inner);
+                );
+            ),
+        (Function,
+            return FMT_CB(ss,
+                if(te.m_abi != "Rust")
+                    ss << "extern_" << escape_str(te.m_abi) << "_";
+                if(te.is_unsafe)
+                    ss << "unsafe_";
+                ss << "fn_" << te.m_arg_types.size();
+                for(const auto& ty : te.m_arg_types)
+                    ss << "_" << mangle(ty);
+                ss << "_" << mangle(*te.m_rettype);
+                );
+            ),
+        (Closure,
+            BUG(Span(), "Closure during trans - " << ty);
+            )
+        )
+
+        throw "";
+    }
+
+    /// Long names are cut down to this many characters, followed by `$h` and a 64-bit hash of the full name
+    const size_t COMPACT_PREFIX_LEN = 40;
+    const size_t COMPACT_THRESHOLD = 64;
+    ::std::string compact_name(::std::string name)
+    {
+        if( name.size() <= COMPACT_THRESHOLD )
+            return name;
+        // FNV-1a
+        uint64_t    hash = 0xcbf29ce484222325;
+        for(unsigned char c : name)
+        {
+            hash ^= c;
+            hash *= 0x100000001b3;
         }
-        for(const auto& comp : path.m_components) {
-            auto v = escape_str(comp);
-            ss << v.size() << v;
+        ::std::stringstream ss;
+        ss << name.substr(0, COMPACT_PREFIX_LEN) << "$h" << ::std::hex << ::std::setw(16) << ::std::setfill('0') << hash;
+        return ss.str();
+    }
+
+    /// Mangled names, so each instance is only mangled once
+    /// - The returned reference is stable (`::std::map` nodes aren't moved on insert)
+    template<typename T>
+    class MangleCache
+    {
+        ::std::mutex    m_lock;
+        ::std::map<T, ::std::string>    m_entries;
+    public:
+        const ::std::string& get(const T& v)
+        {
+            ::std::lock_guard< ::std::mutex>    lh { m_lock };
+            auto it = m_entries.find(v);
+            if( it == m_entries.end() )
+            {
+                auto name = FMT(mangle(v));
+                if( g_mangle_compact )
+                    name = compact_name(mv$(name));
+                it = m_entries.insert(::std::make_pair( v.clone(), mv$(name) )).first;
+            }
+            return it->second;
         }
-        );
+    };
+    MangleCache< ::HIR::SimplePath> s_cache_simplepath;
+    MangleCache< ::HIR::GenericPath>    s_cache_genericpath;
+    MangleCache< ::HIR::Path>   s_cache_path;
+    MangleCache< ::HIR::TypeRef>    s_cache_type;
+
+    ::FmtLambda emit_cached(const ::std::string& name)
+    {
+        const auto* name_p = &name;
+        return ::FmtLambda([name_p](::std::ostream& os) { os << *name_p; });
+    }
+}
+
+bool g_mangle_compact = false;
+
+::FmtLambda Trans_Mangle(const ::HIR::SimplePath& path)
+{
+    return emit_cached( s_cache_simplepath.get(path) );
 }
 ::FmtLambda Trans_Mangle(const ::HIR::GenericPath& path)
 {
-    return FMT_CB(ss,
-        ss << Trans_Mangle(path.m_path);
-        ss << emit_params(path.m_params);
-        );
+    return emit_cached( s_cache_genericpath.get(path) );
 }
 ::FmtLambda Trans_Mangle(const ::HIR::Path& path)
 {
-    TU_MATCHA( (path.m_data), (pe),
-    (Generic,
-        return Trans_Mangle(pe);
-        ),
-    (UfcsUnknown,
-        BUG(Span(), "UfcsUnknown - " << path);
-        ),
-    (UfcsKnown,
-        return FMT_CB(ss,
-            ss << "_ZRK$aL";
-            ss << Trans_Mangle(*pe.type);
-            ss << "_as_";
-            ss << Trans_Mangle(pe.trait);
-            ss << "$aR";
-            if( pe.item[0] == '#' )
-                ss << (pe.item.size()-1+2) << "$H" << (pe.item.c_str()+1);
-            else
-                ss << pe.item;
-            ss << emit_params(pe.params);
-            );
-        ),
-    (UfcsInherent,
-        return FMT_CB(ss,
-            ss << "_ZRI$aL";
-            ss << Trans_Mangle(*pe.type);
-            ss << "$aR";
-            if( pe.item[0] == '#' )
-                ss << (pe.item.size()-1+2) << "$H" << (pe.item.c_str()+1);
-            else
-                ss << pe.item;
-            ss << emit_params(pe.params);
-            );
-        )
-    )
-    throw "";
+    return emit_cached( s_cache_path.get(path) );
 }
 ::FmtLambda Trans_Mangle(const ::HIR::TypeRef& ty)
 {
-    TU_MATCHA( (ty.m_data), (te),
-    (Infer,
-        BUG(Span(), "Infer in trans");
-        ),
-    (Diverge,
-        return FMT_CB(ss, ss << "$D";);
-        ),
-    (Primitive,
-        return FMT_CB(ss, ss << te;);
-        ),
-    (Path,
-        return Trans_Mangle(te.path);
-        ),
-    (Generic,
-        BUG(Span(), "Generic in trans - " << ty);
-        ),
-    (TraitObject,
-        return FMT_CB(ss,
-            ss << "$pL";
-            ss << Trans_Mangle(te.m_trait.m_path);
-            for(const auto& bound : te.m_trait.m_type_bounds) {
-                ss << "_" << bound.first << "$E" << Trans_Mangle(bound.second);
-            }
-            for(const auto& marker : te.m_markers) {
-                ss << "$P" << Trans_Mangle(marker);
-            }
-            ss << "$pR";
-            );
-        ),
-    (ErasedType,
-        BUG(Span(), "ErasedType in trans - " << ty);
-        ),
-    (Array,
-        return FMT_CB(ss, ss << "$A" << te.size_val << "_" << Trans_Mangle(*te.inner););
-        ),
-    (Slice,
-        return FMT_CB(ss, ss << "$A" << "_" << Trans_Mangle(*te.inner););
-        ),
-    (Tuple,
-        return FMT_CB(ss,
-            ss << "$T" << te.size();
-            for(const auto& t : te)
-                ss << "_" << Trans_Mangle(t);
-            );
-        ),
-    (Borrow,
-        return FMT_CB(ss,
-            ss << "$R";
-            switch(te.type)
-            {
-            case ::HIR::BorrowType::Shared: ss << "s"; break;
-            case ::HIR::BorrowType::Unique: ss << "u"; break;
-            case ::HIR::BorrowType::Owned : ss << "o"; break;
-            }
-            ss << "_" << Trans_Mangle(*te.inner);
-            );
-        ),
-    (Pointer,
-        return FMT_CB(ss,
-            ss << "$S";
-            switch(te.type)
-            {
-            case ::HIR::BorrowType::Shared: ss << "s"; break;
-            case ::HIR::BorrowType::Unique: ss << "u"; break;
-            case ::HIR::BorrowType::Owned : ss << "o"; break;
-            }
-            ss << "_" << Trans_Mangle(*te.inner);
-            );
-        ),
-    (Function,
-        return FMT_CB(ss,
-            if(te.m_abi != "Rust")
-                ss << "extern_" << escape_str(te.m_abi) << "_";
-            if(te.is_unsafe)
-                ss << "unsafe_";
-            ss << "fn_" << te.m_arg_types.size();
-            for(const auto& ty : te.m_arg_types)
-                ss << "_" << Trans_Mangle(ty);
-            ss << "_" << Trans_Mangle(*te.m_rettype);
-            );
-        ),
-    (Closure,
-        BUG(Span(), "Closure during trans - " << ty);
-        )
-    )
-
-    throw "";
+    return emit_cached( s_cache_type.get(ty) );
 }
-
@@ -16,6 +16,11 @@ namespace HIR {
     class TypeRef;
 }
 
+/// Shorten long names to a prefix and a hash of the full name (`-Z compact-mangling`)
+/// - All crates linked together must be built with the same setting
+extern bool g_mangle_compact;
+
+// NOTE: Names are cached (each instance is only mangled once), the returned formatter is valid for the entire run
 extern ::FmtLambda Trans_Mangle(const ::HIR::SimplePath& path);
 extern ::FmtLambda Trans_Mangle(const ::HIR::GenericPath& path);
 extern ::FmtLambda Trans_Mangle(const ::HIR::Path& path);
@@ -7,7 +7,9 @@
  */
 #include "monomorphise.hpp"
 #include <mir/mir.hpp>
+#include <mir/operations.hpp>
 #include <hir/hir.hpp>
+#include <hir/item_path.hpp>
 
 namespace {
     ::MIR::LValue monomorph_LValue(const ::StaticTraitResolve& resolve, const Trans_Params& params, const ::MIR::LValue& tpl)
@@ -333,3 +335,27 @@ namespace {
 
     return ::MIR::FunctionPointer( box$(output).release() );
 }
+
+bool Trans_Monomorphise_Needed(const ::HIR::Function& fcn, const Trans_Params& params)
+{
+    // If this is a provided trait method, it needs to be monomorphised too.
+    bool is_method = ( fcn.m_args.size() > 0 && visit_ty_with(fcn.m_args[0].second, [&](const auto& x){return x == ::HIR::TypeRef("Self",0xFFFF);}) );
+    return params.has_types() || is_method;
+}
+
+::MIR::FunctionPointer Trans_Monomorphise_Function(const ::StaticTraitResolve& resolve, const ::HIR::Path& path, const ::HIR::Function& fcn, const Trans_Params& params)
+{
+    TRACE_FUNCTION_F(path);
+    auto ret_type = params.monomorph(resolve, fcn.m_return);
+    ::HIR::Function::args_t args;
+    for(const auto& a : fcn.m_args)
+        args.push_back(::std::make_pair( ::HIR::Pattern{}, params.monomorph(resolve, a.second) ));
+    auto mir = Trans_Monomorphise(resolve, params, fcn.m_code.m_mir);
+    ::std::string s = FMT(path);
+    ::HIR::ItemPath ip(s);
+    MIR_Validate(resolve, ip, *mir, args, ret_type);
+    MIR_Cleanup(resolve, ip, *mir, args, ret_type);
+    MIR_Optimise(resolve, ip, *mir, args, ret_type);
+    MIR_Validate(resolve, ip, *mir, args, ret_type);
+    return mir;
+}
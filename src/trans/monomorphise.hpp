@@ -12,6 +12,12 @@
 
 namespace HIR {
     class Crate;
+    class Function;
 }
 
 extern ::MIR::FunctionPointer Trans_Monomorphise(const ::StaticTraitResolve& crate, const Trans_Params& params, const ::MIR::FunctionPointer& tpl);
+
+/// Returns true if the body of this function instance has to be monomorphised before it can be emitted
+extern bool Trans_Monomorphise_Needed(const ::HIR::Function& fcn, const Trans_Params& params);
+/// Monomorphise the body of a function instance, then clean up, optimise and validate the result
+extern ::MIR::FunctionPointer Trans_Monomorphise_Function(const ::StaticTraitResolve& resolve, const ::HIR::Path& path, const ::HIR::Function& fcn, const Trans_Params& params);
@@ -39,7 +39,7 @@ TransList_Static* TransList::add_static(::HIR::Path p)
     }
 }
 
-t_cb_generic Trans_Params::get_cb() const
+MonomorphiserPP Trans_Params::get_cb() const
 {
     return monomorphise_type_get_cb(sp, &self_type, &pp_impl, &pp_method);
 }
@@ -10,6 +10,7 @@
 #include <hir/type.hpp>
 #include <hir/path.hpp>
 #include <hir_typeck/common.hpp>
+#include <mir/mir_ptr.hpp>
 
 class StaticTraitResolve;
 namespace HIR {
@@ -30,7 +31,7 @@ struct Trans_Params
         sp(sp)
     {}
 
-    t_cb_generic get_cb() const;
+    MonomorphiserPP get_cb() const;
     ::HIR::TypeRef monomorph(const ::StaticTraitResolve& resolve, const ::HIR::TypeRef& p) const;
     ::HIR::Path monomorph(const ::StaticTraitResolve& resolve, const ::HIR::Path& p) const;
     ::HIR::GenericPath monomorph(const ::StaticTraitResolve& resolve, const ::HIR::GenericPath& p) const;
@@ -45,6 +46,9 @@ struct TransList_Function
 {
     const ::HIR::Function*  ptr;
     Trans_Params    pp;
+    /// Monomorphised (and re-optimised) body, populated during enumeration for instances that need it
+    /// - Consumed by codegen instead of `ptr->m_code.m_mir`
+    ::MIR::FunctionPointer  monomorphised;
 };
 struct TransList_Static
 {
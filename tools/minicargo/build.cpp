@@ -9,6 +9,9 @@
 #include <vector>
 #include <algorithm>
 #include <sstream>  // stringstream
+#include <fstream>
+#include <set>
+#include <cstring>  // memcmp
 #include <cstdlib>  // setenv
 #ifdef _WIN32
 # include <Windows.h>
@@ -253,9 +256,13 @@ bool MiniCargo_Build(const PackageManifest& manifest, BuildOptions opts)
         }
     }
 
-    return manifest.foreach_binaries([&](const auto& bin_target) {
-        return builder.build_target(manifest, bin_target);
-        });
+    if( ! manifest.foreach_binaries([&](const auto& bin_target) { return builder.build_target(manifest, bin_target); }) )
+    {
+        return false;
+    }
+
+    // Libraries are built in the background, ensure that they've all finished
+    return builder.wait_all();
 }
 
 void BuildList::add_dependencies(const PackageManifest& p, unsigned level, bool include_build)
@@ -320,6 +327,31 @@ void BuildList::sort_list()
     }
 }
 
+namespace {
+    /// Read the interface hash from the header of a crate's metadata (written by mrustc's `HIR_Serialise`)
+    bool read_interface_hash(const ::std::string& path, uint64_t& out)
+    {
+        static const char MAGIC[8] = { 'M','R','S','H','I','R','0','1' };
+        ::std::ifstream is(path, ::std::ios_base::in|::std::ios_base::binary);
+        unsigned char header[16];
+        is.read(reinterpret_cast<char*>(header), sizeof(header));
+        if( is.gcount() != sizeof(header) || memcmp(header, MAGIC, sizeof(MAGIC)) != 0 )
+            return false;
+        out = 0;
+        for(int i = 0; i < 8; i ++)
+            out |= static_cast<uint64_t>(header[8 + i]) << (i * 8);
+        return true;
+    }
+    /// Contents of a file (empty if it doesn't exist)
+    ::std::string read_file(const ::helpers::path& path)
+    {
+        ::std::ifstream is(path.str());
+        ::std::stringstream ss;
+        ss << is.rdbuf();
+        return ss.str();
+    }
+}
+
 Builder::Builder(BuildOptions opts):
     m_opts(::std::move(opts))
 {
@@ -388,8 +420,11 @@ bool Builder::build_target(const PackageManifest& manifest, const PackageTarget&
     // > mrustc/minicargo is newer than `outfile`
     // > build script has changed
     // > any input file has changed (requires depfile from mrustc)
+    // > (libraries) the interface hash of a dependency has changed
+    // > (binaries) a dependency has been rebuilt
     bool force_rebuild = false;
     auto ts_result = this->get_timestamp(outfile);
+    ::std::string   dep_hashes;
     if( force_rebuild ) {
         DEBUG("Building " << outfile << " - Force");
     }
@@ -401,8 +436,29 @@ bool Builder::build_target(const PackageManifest& manifest, const PackageTarget&
         // Rebuild (older than mrustc/minicargo)
         DEBUG("Building " << outfile << " - Older than mrustc ( " << ts_result << " < " << this->get_timestamp(m_compiler_path) << ")");
     }
+    else if( target.m_type == PackageTarget::Type::Lib && this->get_timestamp(outfile + ".o") < ts_result ) {
+        // The metadata is written before codegen, so it can exist without the object file (interrupted/failed build).
+        // The object file is removed when a build starts and is the last thing written, so marks completion.
+        DEBUG("Building " << outfile << " - Previous build didn't complete");
+    }
+    else if( target.m_type == PackageTarget::Type::Lib && !this->get_dependency_hashes(manifest, dep_hashes) ) {
+        return false;
+    }
+    else if( target.m_type == PackageTarget::Type::Lib && read_file(outfile + ".dephash") != dep_hashes ) {
+        // Libraries only see the metadata of their dependencies, so only need rebuilding if a dependency's interface
+        // changed (not just its code)
+        DEBUG("Building " << outfile << " - Dependency interface changed");
+    }
+    else if( target.m_type != PackageTarget::Type::Lib && !this->wait_all() ) {
+        // A background library build failed (the dependencies' code must be complete before checking timestamps)
+        return false;
+    }
+    else if( target.m_type != PackageTarget::Type::Lib && this->dependency_newer(manifest, ts_result) ) {
+        // Binaries link the code of their dependencies, so use timestamps (the metadata is rewritten on every build)
+        DEBUG("Building " << outfile << " - Dependency rebuilt");
+    }
     else {
-        // TODO: Check dependencies. (from depfile)
+        // TODO: Check source files. (from depfile)
         // Don't rebuild (no need to)
         DEBUG("Not building " << outfile << " - not out of date");
         return true;
@@ -413,6 +469,15 @@ bool Builder::build_target(const PackageManifest& manifest, const PackageTarget&
         // TODO: Run commands specified by build script (override)
     }
 
+    // Binaries link against the object files of all dependencies, so need all library builds to be complete.
+    // Libraries only need the metadata of their direct dependencies (see `wait_for_metadata` below)
+    bool is_lib = (target.m_type == PackageTarget::Type::Lib);
+    if( !is_lib )
+    {
+        if( !this->wait_all() )
+            return false;
+    }
+
     ::std::cout << "BUILDING " << target.m_name << " from " << manifest.name() << " v" << manifest.version() << " with features [" << manifest.active_features() << "]" << ::std::endl;
     StringList  args;
     args.push_back(::helpers::path(manifest.manifest_path()).parent() / ::helpers::path(target.m_path));
@@ -451,6 +516,8 @@ bool Builder::build_target(const PackageManifest& manifest, const PackageTarget&
         {
             const auto& m = dep.get_package();
             auto path = this->get_crate_path(m, m.get_library(), nullptr, nullptr);
+            if( !this->wait_for_metadata(path) )
+                return false;
             args.push_back("--extern");
             args.push_back(::format(m.get_library().m_name, "=", path));
         }
@@ -468,12 +535,41 @@ bool Builder::build_target(const PackageManifest& manifest, const PackageTarget&
     env.push_back("CARGO_MANIFEST_DIR", manifest.directory().to_absolute());
     env.push_back("CARGO_PKG_VERSION", ::format(manifest.version()));
 
-    return this->spawn_process_mrustc(args, ::std::move(env), outfile + "_dbg.txt");
+    if( !is_lib )
+    {
+        return this->spawn_process_mrustc(args, ::std::move(env), outfile + "_dbg.txt");
+    }
+
+    // Libraries are built in the background, limited to `max_jobs` at once
+    while( m_running.size() >= ::std::max(m_opts.max_jobs, 1u) )
+    {
+        if( !this->poll_running() )
+            return false;
+    }
+    // Remove the old output, so its presence indicates that the new metadata is ready
+    remove(outfile.str().c_str());
+    // - And the object file, which marks that the build completed
+    remove((outfile + ".o").str().c_str());
+    if( dep_hashes.empty() && !this->get_dependency_hashes(manifest, dep_hashes) )
+        return false;
+    ProcessHandle   handle;
+    if( !this->start_process(m_compiler_path.str().c_str(), args, env, outfile + "_dbg.txt", &handle) )
+        return false;
+    m_running.push_back(RunningBuild { handle, outfile, ::std::move(dep_hashes) });
+    if( m_opts.max_jobs <= 1 )
+    {
+        return this->wait_all();
+    }
+    return true;
 }
 ::std::string Builder::build_build_script(const PackageManifest& manifest) const
 {
     auto outfile = m_opts.output_dir / manifest.name() + "_build" EXESUF;
 
+    // The build script is linked against its dependencies, so they must be completely built
+    if( !this->wait_all() )
+        return "";
+
     StringList  args;
     args.push_back( ::helpers::path(manifest.manifest_path()).parent() / ::helpers::path(manifest.build_script()) );
     args.push_back("--crate-name"); args.push_back("build");
@@ -604,6 +700,15 @@ bool Builder::spawn_process_mrustc(const StringList& args, StringListKV env, con
     return spawn_process(m_compiler_path.str().c_str(), args, env, logfile);
 }
 bool Builder::spawn_process(const char* exe_name, const StringList& args, const StringListKV& env, const ::helpers::path& logfile) const
+{
+    ProcessHandle   handle;
+    if( !this->start_process(exe_name, args, env, logfile, &handle) )
+        return false;
+    bool failed = false;
+    this->wait_process(handle, /*block=*/true, &failed);
+    return !failed;
+}
+bool Builder::start_process(const char* exe_name, const StringList& args, const StringListKV& env, const ::helpers::path& logfile, ProcessHandle* out_handle) const
 {
 #ifdef _WIN32
     ::std::stringstream cmdline;
@@ -647,16 +752,15 @@ bool Builder::spawn_process(const char* exe_name, const StringList& args, const
         WriteFile(si.hStdOutput, "\n", 1, &tmp, NULL);
     }
     PROCESS_INFORMATION pi = { 0 };
-    CreateProcessA(exe_name, (LPSTR)cmdline_str.c_str(), NULL, NULL, TRUE, 0, NULL, NULL, &si, &pi);
-    CloseHandle(si.hStdOutput);
-    WaitForSingleObject(pi.hProcess, INFINITE);
-    DWORD status = 1;
-    GetExitCodeProcess(pi.hProcess, &status);
-    if (status != 0)
+    if( !CreateProcessA(exe_name, (LPSTR)cmdline_str.c_str(), NULL, NULL, TRUE, 0, NULL, NULL, &si, &pi) )
     {
-        DEBUG("Compiler exited with non-zero exit status " << status);
+        DEBUG("Unable to spawn compiler");
+        CloseHandle(si.hStdOutput);
         return false;
     }
+    CloseHandle(si.hStdOutput);
+    CloseHandle(pi.hThread);
+    *out_handle = pi.hProcess;
 #else
 
     // Create logfile output directory
@@ -709,8 +813,27 @@ bool Builder::spawn_process(const char* exe_name, const StringList& args, const
         return false;
     }
     posix_spawn_file_actions_destroy(&fa);
+    *out_handle = pid;
+#endif
+    return true;
+}
+bool Builder::wait_process(ProcessHandle handle, bool block, bool* out_failed) const
+{
+#ifdef _WIN32
+    if( WaitForSingleObject(handle, block ? INFINITE : 0) == WAIT_TIMEOUT )
+        return false;
+    DWORD status = 1;
+    GetExitCodeProcess(handle, &status);
+    CloseHandle(handle);
+    if (status != 0)
+    {
+        DEBUG("Compiler exited with non-zero exit status " << status);
+        *out_failed = true;
+    }
+#else
     int status = -1;
-    waitpid(pid, &status, 0);
+    if( waitpid(handle, &status, block ? 0 : WNOHANG) == 0 )
+        return false;
     if( status != 0 )
     {
         if( WIFEXITED(status) )
@@ -719,11 +842,123 @@ bool Builder::spawn_process(const char* exe_name, const StringList& args, const
             DEBUG("Compiler was terminated with signal " << WTERMSIG(status));
         else
             DEBUG("Compiler terminated for unknown reason, status=" << status);
-        return false;
+        *out_failed = true;
+    }
+#endif
+    return true;
+}
+
+bool Builder::poll_running() const
+{
+    bool any_exited = false;
+    bool any_failed = false;
+    for(auto it = m_running.begin(); it != m_running.end(); )
+    {
+        bool failed = false;
+        if( this->wait_process(it->handle, /*block=*/false, &failed) )
+        {
+            if( failed )
+            {
+                ::std::cerr << "Build of " << it->outfile << " failed, see " << (it->outfile + "_dbg.txt") << ::std::endl;
+                // Remove the metadata (written before codegen), so the failed crate isn't considered up-to-date
+                remove(it->outfile.str().c_str());
+                any_failed = true;
+            }
+            else
+            {
+                ::std::ofstream(( it->outfile + ".dephash" ).str()) << it->dep_hashes;
+            }
+            it = m_running.erase(it);
+            any_exited = true;
+        }
+        else
+        {
+            ++ it;
+        }
     }
+    if( !any_exited )
+    {
+        // Nothing has changed, sleep for a bit before the caller checks again
+#ifdef _WIN32
+        Sleep(50);
+#else
+        usleep(50*1000);
 #endif
+    }
+    return !any_failed;
+}
+bool Builder::wait_for_metadata(const ::helpers::path& outfile) const
+{
+    for(;;)
+    {
+        auto it = ::std::find_if(m_running.begin(), m_running.end(), [&](const auto& b){ return b.outfile.str() == outfile.str(); });
+        if( it == m_running.end() )
+            return true;
+        // mrustc writes the metadata (atomically) before starting codegen, and the old file was removed on spawn
+        if( !(this->get_timestamp(outfile) == Timestamp::infinite_past()) )
+            return true;
+        if( !this->poll_running() )
+            return false;
+    }
+}
+void Builder::collect_dependency_paths(const PackageManifest& manifest, ::std::set< ::std::string>& out) const
+{
+    for(const auto& dep : manifest.dependencies())
+    {
+        if( dep.is_disabled() )
+            continue ;
+        const auto& m = dep.get_package();
+        if( out.insert( this->get_crate_path(m, m.get_library(), nullptr, nullptr).str() ).second )
+        {
+            this->collect_dependency_paths(m, out);
+        }
+    }
+}
+bool Builder::dependency_newer(const PackageManifest& manifest, const Timestamp& ts) const
+{
+    // NOTE: The caller must have waited for all running builds (the dependencies' code must be complete)
+    ::std::set< ::std::string>  paths;
+    this->collect_dependency_paths(manifest, paths);
+    for(const auto& p : paths)
+    {
+        if( ts < this->get_timestamp(p) )
+            return true;
+    }
+    return false;
+}
+bool Builder::get_dependency_hashes(const PackageManifest& manifest, ::std::string& out) const
+{
+    ::std::set< ::std::string>  paths;
+    this->collect_dependency_paths(manifest, paths);
+
+    ::std::stringstream ss;
+    for(const auto& p : paths)
+    {
+        if( !this->wait_for_metadata(p) )
+            return false;
+        uint64_t    hash;
+        if( !read_interface_hash(p, hash) )
+        {
+            ::std::cerr << "Unable to read metadata header from " << p << ::std::endl;
+            return false;
+        }
+        ss << p << " " << ::std::hex << hash << ::std::dec << "\n";
+    }
+    // Never empty, so an empty string can mean "not yet computed"
+    ss << "-\n";
+    out = ss.str();
     return true;
 }
+bool Builder::wait_all() const
+{
+    bool rv = true;
+    while( !m_running.empty() )
+    {
+        if( !this->poll_running() )
+            rv = false;
+    }
+    return rv;
+}
 
 Timestamp Builder::get_timestamp(const ::helpers::path& path) const
 {
@@ -2,16 +2,28 @@
 
 #include "manifest.h"
 #include "path.h"
+#include <set>
 
 class StringList;
 class StringListKV;
 struct Timestamp;
 
+#ifdef _WIN32
+typedef void*   ProcessHandle;  // `HANDLE`
+#else
+typedef int ProcessHandle;  // `pid_t`
+#endif
+
 struct BuildOptions
 {
     ::helpers::path output_dir;
     ::helpers::path build_script_overrides;
     ::std::vector<::helpers::path>  lib_search_dirs;
+
+    // Maximum number of library builds running at once
+    // - Dependent crates are started as soon as their dependencies' metadata exists (mrustc writes it before C
+    //   codegen), so values above 1 let a crate's codegen overlap with the front-end of the crates that use it.
+    unsigned max_jobs = 2;
 };
 
 class Builder
@@ -19,6 +31,15 @@ class Builder
     BuildOptions    m_opts;
     ::helpers::path m_compiler_path;
 
+    // Library builds that have been started, but not yet waited upon
+    struct RunningBuild {
+        ProcessHandle   handle;
+        ::helpers::path outfile;
+        /// Dependency interface hashes to record once the build succeeds (see `get_dependency_hashes`)
+        ::std::string   dep_hashes;
+    };
+    mutable ::std::vector<RunningBuild>  m_running;
+
 public:
     Builder(BuildOptions opts);
 
@@ -26,10 +47,28 @@ public:
     bool build_library(const PackageManifest& manifest) const;
     ::std::string build_build_script(const PackageManifest& manifest) const;
 
+    /// Wait for all outstanding library builds to complete (needed before anything that links against them)
+    bool wait_all() const;
+
 private:
     ::helpers::path get_crate_path(const PackageManifest& manifest, const PackageTarget& target, const char** crate_type, ::std::string* out_crate_suffix) const;
     bool spawn_process_mrustc(const StringList& args, StringListKV env, const ::helpers::path& logfile) const;
     bool spawn_process(const char* exe_name, const StringList& args, const StringListKV& env, const ::helpers::path& logfile) const;
+    bool start_process(const char* exe_name, const StringList& args, const StringListKV& env, const ::helpers::path& logfile, ProcessHandle* out_handle) const;
+    /// Check (or block on) a process, returns true once it has exited (with `out_failed` set if it was unsuccessful)
+    bool wait_process(ProcessHandle handle, bool block, bool* out_failed) const;
+
+    /// Poll running builds, removing any that have finished. Returns false if any build failed.
+    bool poll_running() const;
+    /// Wait until the metadata for the given (library) output is available
+    bool wait_for_metadata(const ::helpers::path& outfile) const;
+    /// Get the interface hashes of every library loaded when building this package (direct and indirect dependencies)
+    /// - Waits for their metadata. Returns false if any metadata couldn't be read.
+    bool get_dependency_hashes(const PackageManifest& manifest, ::std::string& out) const;
+    /// Output paths of every library loaded when building this package
+    void collect_dependency_paths(const PackageManifest& manifest, ::std::set< ::std::string>& out) const;
+    /// Check if any (direct or indirect) dependency was built after the given time
+    bool dependency_newer(const PackageManifest& manifest, const Timestamp& ts) const;
 
 
     Timestamp get_timestamp(const ::helpers::path& path) const;
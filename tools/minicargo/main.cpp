@@ -6,6 +6,7 @@
  */
 #include <iostream>
 #include <cstring>  // strcmp
+#include <cstdlib>  // strtoul
 #include <map>
 #include "debug.h"
 #include "manifest.h"
@@ -30,6 +31,9 @@ struct ProgramOptions
     // Library search directories
     ::std::vector<const char*>  lib_search_dirs;
 
+    // Maximum number of concurrent library builds (0 = use default)
+    unsigned max_jobs = 0;
+
     bool pause_before_quit = false;
 
     int parse(int argc, const char* argv[]);
@@ -69,6 +73,8 @@ int main(int argc, const char* argv[])
         build_opts.lib_search_dirs.reserve(opts.lib_search_dirs.size());
         for(const auto* d : opts.lib_search_dirs)
             build_opts.lib_search_dirs.push_back( ::helpers::path(d) );
+        if( opts.max_jobs > 0 )
+            build_opts.max_jobs = opts.max_jobs;
         if( !MiniCargo_Build(m, ::std::move(build_opts)) )
         {
             ::std::cerr << "BUILD FAILED" << ::std::endl;
@@ -130,6 +136,13 @@ int ProgramOptions::parse(int argc, const char* argv[])
                 }
                 this->output_directory = argv[++i];
                 break;
+            case 'j':
+                if(i+1 == argc) {
+                    ::std::cerr << "Flag " << arg << " takes an argument" << ::std::endl;
+                    return 1;
+                }
+                this->max_jobs = ::std::strtoul(argv[++i], nullptr, 10);
+                break;
             case 'h':
                 break;
             default:
@@ -185,6 +198,7 @@ void ProgramOptions::usage() const
 {
     ::std::cerr
         << "Usage: minicargo <package dir>" << ::std::endl
+        << "  -j <count>   Maximum number of concurrent library builds (default 2)" << ::std::endl
         ;
 }
 